@@ -1,8 +1,13 @@
 #pragma once
 
+#include "async/broadcast_channel.h"
 #include "async/channel.h"
+#include "async/combining_mutex.h"
 #include "async/lock.h"
 #include "async/manual_reset_event.h"
 #include "async/mutex.h"
+#include "async/rate_limiter.h"
 #include "async/scope.h"
+#include "async/select.h"
+#include "async/semaphore.h"
 #include "async/shared_mutex.h"
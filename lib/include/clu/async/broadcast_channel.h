@@ -0,0 +1,478 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include "channel.h"
+#include "../intrusive_list.h"
+
+namespace clu::async
+{
+    template <movable_value T, //
+        buffer_overflow_policy OverflowPolicy = buffer_overflow_policies::suspend_t, //
+        allocator Alloc = std::allocator<T>>
+    class broadcast_channel;
+
+    namespace detail::bchnl
+    {
+        // A sent value, shared by the ring and the receiving operations completing with it, so that
+        // the slot in the ring can be reused without waiting for the completions to return
+        template <typename T, typename Alloc>
+        class value_node
+        {
+        public:
+            using value_type = T;
+            using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<value_node>;
+
+            value_node* next = nullptr; // Used while the node waits along with its sending operation
+
+            // clang-format off
+            template <typename U>
+            value_node(const allocator_type& alloc, U&& value):
+                alloc_(alloc), value_(static_cast<U&&>(value)) {}
+            // clang-format on
+
+            CLU_IMMOVABLE_TYPE(value_node);
+            ~value_node() noexcept = default;
+
+            template <typename U>
+            static value_node* make(allocator_type alloc, U&& value)
+            {
+                value_node* ptr = node_traits::allocate(alloc, 1);
+                scope_fail guard([&]() noexcept { node_traits::deallocate(alloc, ptr, 1); });
+                node_traits::construct(alloc, ptr, alloc, static_cast<U&&>(value));
+                return ptr;
+            }
+
+            const T& value() const noexcept { return value_; }
+            void add_ref() noexcept { refs_.fetch_add(1, std::memory_order::relaxed); }
+
+            void release() noexcept
+            {
+                if (refs_.fetch_sub(1, std::memory_order::acq_rel) != 1)
+                    return;
+                allocator_type alloc = alloc_;
+                node_traits::destroy(alloc, this);
+                node_traits::deallocate(alloc, this, 1);
+            }
+
+        private:
+            using node_traits = std::allocator_traits<allocator_type>;
+
+            std::atomic_size_t refs_ = 1;
+            CLU_NO_UNIQUE_ADDRESS allocator_type alloc_;
+            T value_;
+        };
+
+        // Sending goes through the operations of detail::chnl, receiving completes
+        // with const references to the shared values and thus has its own operations
+        template <typename N, typename S>
+        class recv_ops_base
+        {
+        public:
+            recv_ops_base* next = nullptr;
+            N* node = nullptr; // The value to complete with, referenced until the completion returns
+
+            explicit recv_ops_base(S* sub) noexcept: sub_(sub) {}
+            CLU_IMMOVABLE_TYPE(recv_ops_base);
+            virtual void set_value(const typename N::value_type& value) noexcept = 0;
+            virtual void set_stopped() noexcept = 0;
+
+        protected:
+            ~recv_ops_base() noexcept = default;
+            void enqueue() noexcept { sub_->enqueue(this); }
+
+        private:
+            S* sub_ = nullptr;
+        };
+
+        template <typename N, typename S, typename R>
+        struct recv_ops_t_
+        {
+            class type;
+        };
+
+        template <typename N, typename S, typename R>
+        using recv_ops_t = typename recv_ops_t_<N, S, std::decay_t<R>>::type;
+
+        template <typename N, typename S, typename R>
+        class recv_ops_t_<N, S, R>::type final : public recv_ops_base<N, S>
+        {
+        public:
+            // clang-format off
+            template <typename R2>
+            type(S* sub, R2&& recv):
+                recv_ops_base<N, S>(sub),
+                recv_(static_cast<R2&&>(recv)) {}
+            // clang-format on
+
+            void set_value(const typename N::value_type& value) noexcept override
+            {
+                exec::set_value(static_cast<R&&>(recv_), value);
+            }
+
+            void set_stopped() noexcept override { exec::set_stopped(static_cast<R&&>(recv_)); }
+
+        private:
+            CLU_NO_UNIQUE_ADDRESS R recv_;
+
+            friend void tag_invoke(exec::start_t, type& self) noexcept { self.enqueue(); }
+        };
+
+        template <typename N, typename S>
+        struct recv_snd_t_
+        {
+            class type;
+        };
+
+        template <typename N, typename S>
+        using recv_snd_t = typename recv_snd_t_<N, S>::type;
+
+        template <typename N, typename S>
+        class recv_snd_t_<N, S>::type
+        {
+        public:
+            using is_sender = void;
+
+            explicit type(S* sub) noexcept: sub_(sub) {}
+
+            using completion_signatures = exec::completion_signatures< //
+                exec::set_value_t(const typename N::value_type&), exec::set_stopped_t()>;
+
+        private:
+            S* sub_;
+
+            template <typename R>
+            friend auto tag_invoke(exec::connect_t, type&& self, R&& recv)
+            {
+                return recv_ops_t<N, S, R>(self.sub_, static_cast<R&&>(recv));
+            }
+        };
+    } // namespace detail::bchnl
+
+    /**
+     * \brief A channel that delivers every value to all of its subscribers.
+     * \details Every value is stored once, in a node referenced from a shared ring, and each subscriber reads the
+     * ring at its own cursor, like a disruptor. Subscribers get const references to the stored values, a value is
+     * kept alive while a receiving operation completes with it. When the ring is full, the "suspend" policy makes
+     * senders wait for the slowest subscriber, and the "drop_oldest" policy skips lagging subscribers over the
+     * oldest value. The operations are completed after the channel is done with its state, so a completion may
+     * destroy the channel.
+     * \tparam T The value type.
+     * \tparam P The buffer overflow policy, only "suspend" and "drop_oldest" are supported.
+     * \tparam Alloc Allocator type for the ring and the values.
+     */
+    template <movable_value T, buffer_overflow_policy P, allocator Alloc>
+    class broadcast_channel
+    {
+        static_assert(!std::is_same_v<P, buffer_overflow_policies::drop_latest_t>,
+            "broadcast_channel only supports the \"suspend\" and \"drop_oldest\" buffer overflow policies");
+
+        using node_type = detail::bchnl::value_node<T, Alloc>;
+
+    public:
+        /// A handle for receiving values from the channel, which must not outlive the channel.
+        class subscriber : public intrusive_list_element_base<subscriber>
+        {
+        public:
+            CLU_IMMOVABLE_TYPE(subscriber);
+            ~subscriber() noexcept { chnl_->unsubscribe(*this); }
+
+            /**
+             * \brief Receives a value if there is one available.
+             * \param func Function to be called with a const reference to the value.
+             * \return Whether a value was received.
+             */
+            template <std::invocable<const T&> F>
+            bool try_receive(F&& func)
+            {
+                node_type* node = nullptr;
+                completions done;
+                {
+                    std::unique_lock lck(chnl_->mtx_);
+                    if (next_ == chnl_->tail_)
+                        return false;
+                    node = chnl_->slot_at(next_++);
+                    node->add_ref();
+                    chnl_->progress(done); // We may have been holding back the senders
+                }
+                scope_exit guard{[=] { node->release(); }};
+                done.complete();
+                (void)static_cast<F&&>(func)(node->value());
+                return true;
+            }
+
+            /**
+             * \brief Receives a value asynchronously. Only one receiving operation may be pending on a subscriber.
+             * \return A sender which completes with a const reference to the value, which is only valid until
+             * the completion returns.
+             */
+            [[nodiscard]] auto receive_async() noexcept
+            {
+                return detail::bchnl::recv_snd_t<node_type, subscriber>(this);
+            }
+
+        private:
+            friend broadcast_channel;
+            using recv_ops_base = detail::bchnl::recv_ops_base<node_type, subscriber>;
+            friend recv_ops_base;
+
+            broadcast_channel* chnl_;
+            std::size_t next_ = 0; // Sequence number of the next value to receive
+            recv_ops_base* waiting_ = nullptr;
+
+            explicit subscriber(broadcast_channel* chnl): chnl_(chnl) { chnl_->subscribe(*this); }
+            void enqueue(recv_ops_base* ops) noexcept { chnl_->enqueue_recv_ops(*this, ops); }
+        };
+
+        explicit broadcast_channel(const std::size_t capacity, const Alloc alloc = Alloc{}):
+            alloc_(alloc), capacity_(capacity), slots_(slot_traits::allocate(alloc_, capacity_))
+        {
+            CLU_ASSERT(capacity != 0 && capacity != unbounded, "broadcast_channel needs a fixed non-zero capacity");
+        }
+
+        ~broadcast_channel() noexcept
+        {
+            CLU_ASSERT(subs_.empty(), "subscribers must not outlive the broadcast_channel");
+            cancel(); // Also releases all the values, since no one is subscribed
+            slot_traits::deallocate(alloc_, slots_, capacity_);
+        }
+
+        /// Subscribes to the channel, the subscriber receives values sent after this call.
+        [[nodiscard]] subscriber subscribe() { return subscriber(this); }
+
+        template <forwarding<T> U>
+        bool try_send(U&& value)
+        {
+            completions done;
+            {
+                std::unique_lock lck(mtx_);
+                if (snd_queue_.peek() || !this->has_room())
+                    return false;
+                this->push(node_type::make(alloc_, static_cast<U&&>(value)));
+                this->progress(done);
+            }
+            done.complete();
+            return true;
+        }
+
+        template <forwarding<T> U>
+        [[nodiscard]] auto send_async(U&& value)
+        {
+            return detail::chnl::snd_snd_t<T, broadcast_channel>(this, static_cast<U&&>(value));
+        }
+
+        /// Stops all pending operations, values which are not yet received are dropped.
+        void cancel() noexcept
+        {
+            std::unique_lock lck(mtx_);
+            auto sndq = std::move(snd_queue_);
+            auto nodes = std::move(snd_nodes_);
+            detail::chnl::intrusive_queue<recv_ops_base> recvq;
+            for (subscriber& sub : subs_)
+            {
+                if (sub.waiting_)
+                    recvq.push(*std::exchange(sub.waiting_, nullptr));
+                sub.next_ = tail_;
+            }
+            waiting_count_ = 0;
+            this->reclaim();
+            lck.unlock(); // Avoid calling arbitrary callback (set_stopped) while holding the lock
+            while (auto* ptr = nodes.pop())
+                ptr->release();
+            while (auto* ptr = sndq.pop())
+                ptr->set_stopped();
+            while (auto* ptr = recvq.pop())
+                ptr->set_stopped();
+        }
+
+    private:
+        using snd_ops_base = detail::chnl::snd_ops_base<T, broadcast_channel>;
+        using recv_ops_base = typename subscriber::recv_ops_base;
+        friend snd_ops_base;
+
+        /*
+         * The operations to be completed once the channel is done with its state. The completions may
+         * destroy the channel, so complete() must be the last thing done with it, and does not touch it.
+         */
+        class completions
+        {
+        public:
+            detail::chnl::intrusive_queue<snd_ops_base> senders;
+            detail::chnl::intrusive_queue<recv_ops_base> receivers; // Each holds a reference to its node
+
+            void complete() noexcept
+            {
+                while (auto* ptr = senders.pop())
+                    ptr->set_value();
+                while (auto* ptr = receivers.pop())
+                {
+                    node_type* node = ptr->node; // The operation may be gone after set_value
+                    ptr->set_value(node->value());
+                    node->release();
+                }
+            }
+        };
+
+        using slot_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<node_type*>;
+        using slot_traits = std::allocator_traits<slot_alloc>;
+
+        CLU_NO_UNIQUE_ADDRESS slot_alloc alloc_;
+        std::size_t capacity_;
+        node_type** slots_ = nullptr;
+        std::mutex mtx_;
+        std::size_t head_ = 0; // Sequence number of the oldest value in the ring
+        std::size_t tail_ = 0; // Sequence number of the next value to be sent
+        intrusive_list<subscriber> subs_;
+        std::size_t waiting_count_ = 0; // Number of subscribers with a pending receiving operation
+        detail::chnl::intrusive_queue<snd_ops_base> snd_queue_;
+        detail::chnl::intrusive_queue<node_type> snd_nodes_; // The values of the operations in snd_queue_
+
+        node_type*& slot_at(const std::size_t seq) const noexcept { return slots_[seq % capacity_]; }
+
+        void subscribe(subscriber& sub)
+        {
+            std::unique_lock lck(mtx_);
+            sub.next_ = tail_;
+            subs_.push_back(sub);
+        }
+
+        void unsubscribe(subscriber& sub) noexcept
+        {
+            completions done;
+            recv_ops_base* ops = nullptr;
+            {
+                std::unique_lock lck(mtx_);
+                subs_.erase(subs_.get_iterator(sub));
+                ops = std::exchange(sub.waiting_, nullptr);
+                if (ops)
+                    waiting_count_--;
+                this->progress(done); // The subscriber may have been holding back the senders
+            }
+            if (ops)
+                ops->set_stopped();
+            done.complete();
+        }
+
+        // Releases the values which every subscriber has gone past
+        void reclaim() noexcept
+        {
+            std::size_t min_next = tail_;
+            for (const subscriber& sub : subs_)
+                min_next = (std::min)(min_next, sub.next_);
+            for (; head_ != min_next; head_++)
+                slot_at(head_)->release();
+        }
+
+        bool has_room() noexcept
+        {
+            if constexpr (std::is_same_v<P, buffer_overflow_policies::drop_oldest_t>)
+                return true;
+            else
+            {
+                if (tail_ - head_ == capacity_)
+                    this->reclaim();
+                return tail_ - head_ != capacity_;
+            }
+        }
+
+        void push(node_type* node) noexcept
+        {
+            if (tail_ - head_ == capacity_)
+                this->reclaim();
+            if constexpr (std::is_same_v<P, buffer_overflow_policies::drop_oldest_t>)
+            {
+                if (tail_ - head_ == capacity_)
+                {
+                    // Skip the lagging subscribers over the oldest value
+                    for (subscriber& sub : subs_)
+                        if (sub.next_ == head_)
+                            sub.next_++;
+                    slot_at(head_++)->release();
+                }
+            }
+            CLU_ASSERT(tail_ - head_ < capacity_, "Trying to push into a full broadcast_channel");
+            slot_at(tail_++) = node;
+        }
+
+        /*
+         * Hands the values over to the pending receiving operations, and lets the pending sending operations
+         * push their values while there is room, until neither side can make progress. The finished
+         * operations are added to done, to be completed after the lock is released.
+         */
+        void progress(completions& done) noexcept
+        {
+            while (true)
+            {
+                if (waiting_count_ != 0)
+                {
+                    for (subscriber& sub : subs_)
+                    {
+                        if (!sub.waiting_ || sub.next_ == tail_)
+                            continue;
+                        recv_ops_base* ops = std::exchange(sub.waiting_, nullptr);
+                        ops->node = slot_at(sub.next_++);
+                        ops->node->add_ref();
+                        done.receivers.push(*ops);
+                        waiting_count_--;
+                    }
+                }
+                if (!snd_queue_.peek() || !this->has_room())
+                    return;
+                while (auto* ptr = snd_queue_.peek())
+                {
+                    if (!this->has_room())
+                        break;
+                    this->push(snd_nodes_.pop());
+                    (void)snd_queue_.pop();
+                    done.senders.push(*ptr);
+                }
+            }
+        }
+
+        void enqueue_snd_ops(snd_ops_base* ops) noexcept
+        {
+            CLU_ASSERT(ops->last - ops->first == 1, "broadcast_channel sends one value per operation");
+            // Make the node beforehand, so that pushing it never throws
+            node_type* node = nullptr;
+            try
+            {
+                node = node_type::make(alloc_, std::move(*ops->first));
+            }
+            catch (...)
+            {
+                ops->set_error();
+                return;
+            }
+            completions done;
+            {
+                std::unique_lock lck(mtx_);
+                snd_queue_.push(*ops); // Wait in line if others are already waiting
+                snd_nodes_.push(*node);
+                this->progress(done);
+            }
+            done.complete();
+        }
+
+        void enqueue_recv_ops(subscriber& sub, recv_ops_base* ops) noexcept
+        {
+            completions done;
+            {
+                std::unique_lock lck(mtx_);
+                CLU_ASSERT(!sub.waiting_, "only one receiving operation may be pending on a subscriber");
+                sub.waiting_ = ops;
+                waiting_count_++;
+                this->progress(done);
+            }
+            done.complete();
+        }
+    };
+
+    template <movable_value T, //
+        buffer_overflow_policy P = buffer_overflow_policies::suspend_t, //
+        allocator Alloc = std::allocator<T>>
+    auto make_broadcast_channel(const std::size_t capacity, P = P{}, const Alloc alloc = Alloc{})
+    {
+        return broadcast_channel<T, P, Alloc>(capacity, alloc);
+    }
+} // namespace clu::async
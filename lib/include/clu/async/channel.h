@@ -1,9 +1,17 @@
 #pragma once
 
+#include <atomic>
+#include <bit>
 #include <deque>
+#include <mutex>
 #include <optional>
+#include <ranges>
+#include <span>
+#include <vector>
 
+#include "../concurrency/cache_line.h"
 #include "../execution/utility.h"
+#include "../manual_lifetime.h"
 #include "../scope.h"
 
 namespace clu::async
@@ -239,14 +247,15 @@ namespace clu::async
                 return *this;
             }
 
-            void push(T* node) noexcept
+            void push(T& node) noexcept
             {
+                node.next = nullptr;
                 if (!head_)
-                    head_ = tail_ = node;
+                    head_ = tail_ = &node;
                 else
                 {
-                    tail_->next = node;
-                    tail_ = node;
+                    tail_->next = &node;
+                    tail_ = &node;
                 }
             }
 
@@ -259,19 +268,209 @@ namespace clu::async
                 return nullptr;
             }
 
+            bool remove(T* node) noexcept
+            {
+                T* prev = nullptr;
+                for (T* ptr = head_; ptr; prev = std::exchange(ptr, ptr->next))
+                {
+                    if (ptr != node)
+                        continue;
+                    (prev ? prev->next : head_) = ptr->next;
+                    if (tail_ == node)
+                        tail_ = prev;
+                    return true;
+                }
+                return false;
+            }
+
         private:
             T* head_ = nullptr;
             T* tail_ = nullptr;
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
+        // Single-producer single-consumer ring, the capacity is exact while the storage is rounded up
+        // to a power of two so that indexing is a simple mask
+        template <typename T, typename Alloc>
+        class spsc_ring
+        {
+        public:
+            using allocator_type = Alloc;
+            static constexpr bool multi_consumer = false;
+
+            CLU_IMMOVABLE_TYPE(spsc_ring);
+
+            spsc_ring(const std::size_t capacity, const Alloc alloc):
+                alloc_(alloc), capacity_(capacity), mask_(std::bit_ceil(capacity) - 1),
+                ptr_(alloc_traits::allocate(alloc_, mask_ + 1))
+            {
+            }
+
+            ~spsc_ring() noexcept
+            {
+                clear();
+                alloc_traits::deallocate(alloc_, ptr_, mask_ + 1);
+            }
+
+            // Producer side
+            template <forwarding<T> U>
+                requires std::is_nothrow_constructible_v<T, U>
+            bool try_push(U&& value) noexcept
+            {
+                const std::size_t tail = tail_.load(std::memory_order::relaxed);
+                if (tail - head_cache_ >= capacity_)
+                {
+                    head_cache_ = head_.load(std::memory_order::acquire);
+                    if (tail - head_cache_ >= capacity_)
+                        return false;
+                }
+                alloc_traits::construct(alloc_, ptr_ + (tail & mask_), static_cast<U&&>(value));
+                tail_.store(tail + 1, std::memory_order::release);
+                return true;
+            }
+
+            // Consumer side
+            std::optional<T> try_pop() noexcept
+            {
+                const std::size_t head = head_.load(std::memory_order::relaxed);
+                if (head == tail_cache_)
+                {
+                    tail_cache_ = tail_.load(std::memory_order::acquire);
+                    if (head == tail_cache_)
+                        return std::nullopt;
+                }
+                T* slot = ptr_ + (head & mask_);
+                std::optional<T> result(std::move(*slot));
+                alloc_traits::destroy(alloc_, slot);
+                head_.store(head + 1, std::memory_order::release);
+                return result;
+            }
+
+            void clear() noexcept
+            {
+                while (try_pop()) {}
+            }
+
+        private:
+            using alloc_traits = std::allocator_traits<Alloc>;
+
+            CLU_NO_UNIQUE_ADDRESS Alloc alloc_;
+            std::size_t capacity_;
+            std::size_t mask_;
+            T* ptr_ = nullptr;
+            alignas(clu::detail::cache_line_size) std::atomic_size_t head_ = 0;
+            std::size_t tail_cache_ = 0; // Consumer's view of tail_
+            alignas(clu::detail::cache_line_size) std::atomic_size_t tail_ = 0;
+            std::size_t head_cache_ = 0; // Producer's view of head_
+        };
+
+        // Vyukov's bounded multi-producer multi-consumer array queue
+        template <typename T, typename Alloc>
+        class mpmc_ring
+        {
+        public:
+            using allocator_type = Alloc;
+            static constexpr bool multi_consumer = true;
+
+            CLU_IMMOVABLE_TYPE(mpmc_ring);
+
+            mpmc_ring(const std::size_t capacity, const Alloc alloc):
+                alloc_(alloc), capacity_(capacity), cells_(cell_traits::allocate(alloc_, capacity_))
+            {
+                for (std::size_t i = 0; i < capacity_; i++)
+                    cell_traits::construct(alloc_, cells_ + i, i);
+            }
+
+            ~mpmc_ring() noexcept
+            {
+                clear();
+                for (std::size_t i = 0; i < capacity_; i++)
+                    cell_traits::destroy(alloc_, cells_ + i);
+                cell_traits::deallocate(alloc_, cells_, capacity_);
+            }
+
+            template <forwarding<T> U>
+                requires std::is_nothrow_constructible_v<T, U>
+            bool try_push(U&& value) noexcept
+            {
+                std::size_t pos = enqueue_pos_.load(std::memory_order::relaxed);
+                cell* ptr = nullptr;
+                while (true)
+                {
+                    ptr = cells_ + pos % capacity_;
+                    const std::size_t seq = ptr->sequence.load(std::memory_order::acquire);
+                    const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+                    if (diff == 0)
+                    {
+                        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order::relaxed))
+                            break;
+                    }
+                    else if (diff < 0) // The cell still holds a value from the previous lap
+                        return false;
+                    else
+                        pos = enqueue_pos_.load(std::memory_order::relaxed);
+                }
+                ptr->value.construct(static_cast<U&&>(value));
+                ptr->sequence.store(pos + 1, std::memory_order::release);
+                return true;
+            }
+
+            std::optional<T> try_pop() noexcept
+            {
+                std::size_t pos = dequeue_pos_.load(std::memory_order::relaxed);
+                cell* ptr = nullptr;
+                while (true)
+                {
+                    ptr = cells_ + pos % capacity_;
+                    const std::size_t seq = ptr->sequence.load(std::memory_order::acquire);
+                    const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+                    if (diff == 0)
+                    {
+                        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order::relaxed))
+                            break;
+                    }
+                    else if (diff < 0) // The cell has not been written to in this lap
+                        return std::nullopt;
+                    else
+                        pos = dequeue_pos_.load(std::memory_order::relaxed);
+                }
+                std::optional<T> result(std::move(ptr->value).get());
+                ptr->value.destruct();
+                ptr->sequence.store(pos + capacity_, std::memory_order::release);
+                return result;
+            }
+
+            void clear() noexcept
+            {
+                while (try_pop()) {}
+            }
+
+        private:
+            struct cell
+            {
+                std::atomic_size_t sequence;
+                manual_lifetime<T> value;
+                explicit cell(const std::size_t seq) noexcept: sequence(seq) {}
+            };
+
+            using cell_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<cell>;
+            using cell_traits = std::allocator_traits<cell_alloc>;
+
+            CLU_NO_UNIQUE_ADDRESS cell_alloc alloc_;
+            std::size_t capacity_;
+            cell* cells_ = nullptr;
+            alignas(clu::detail::cache_line_size) std::atomic_size_t enqueue_pos_ = 0;
+            alignas(clu::detail::cache_line_size) std::atomic_size_t dequeue_pos_ = 0;
+        };
+
+        template <typename T, typename C>
         class snd_ops_base
         {
         public:
             snd_ops_base* next = nullptr;
-            T value;
+            T* first; // The values yet to be sent
+            T* last;
 
-            snd_ops_base(channel<T, P, Alloc>* chan, T&& val): value(static_cast<T&&>(val)), chnl_(chan) {}
+            snd_ops_base(C* chan, T* begin, T* end) noexcept: first(begin), last(end), chnl_(chan) {}
             CLU_IMMOVABLE_TYPE(snd_ops_base);
             virtual void set_value() noexcept = 0;
             virtual void set_error() noexcept = 0;
@@ -279,49 +478,60 @@ namespace clu::async
 
         protected:
             ~snd_ops_base() noexcept = default;
-            void enqueue() noexcept;
+            void enqueue() noexcept { chnl_->enqueue_snd_ops(this); }
 
         private:
-            channel<T, P, Alloc>* chnl_ = nullptr;
+            C* chnl_ = nullptr;
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
+        template <typename T, typename C>
         class recv_ops_base
         {
         public:
             recv_ops_base* next = nullptr;
-            explicit recv_ops_base(channel<T, P, Alloc>* chan) noexcept: chnl_(chan) {}
+            explicit recv_ops_base(C* chan) noexcept: chnl_(chan) {}
             CLU_IMMOVABLE_TYPE(recv_ops_base);
             virtual void set_value(T&& value) noexcept = 0;
             virtual void set_error() noexcept = 0;
             virtual void set_stopped() noexcept = 0;
 
+            // Called with the channel locked before completing this operation, an operation waiting on
+            // multiple channels returns false if it has already been completed by another channel
+            virtual bool try_claim() noexcept { return true; }
+
         protected:
             ~recv_ops_base() noexcept = default;
-            void enqueue() noexcept;
+            void enqueue() noexcept { chnl_->enqueue_recv_ops(this); }
+            void dequeue() noexcept { chnl_->dequeue_recv_ops(this); }
+
+            template <typename F>
+            std::size_t receive_into(const std::size_t max, F&& sink)
+            {
+                return chnl_->receive_into(max, static_cast<F&&>(sink));
+            }
 
         private:
-            channel<T, P, Alloc>* chnl_ = nullptr;
+            C* chnl_ = nullptr;
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc, typename R>
+        template <typename T, typename C, typename R>
         struct snd_ops_t_
         {
             class type;
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc, typename R>
-        using snd_ops_t = typename snd_ops_t_<T, P, Alloc, std::decay_t<R>>::type;
+        template <typename T, typename C, typename R>
+        using snd_ops_t = typename snd_ops_t_<T, C, std::decay_t<R>>::type;
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc, typename R>
-        class snd_ops_t_<T, P, Alloc, R>::type final : public snd_ops_base<T, P, Alloc>
+        template <typename T, typename C, typename R>
+        class snd_ops_t_<T, C, R>::type final : public snd_ops_base<T, C>
         {
         public:
             // clang-format off
             template <typename R2>
-            type(channel<T, P, Alloc>* chan, T&& val, R2&& recv):
-                snd_ops_base<T, P, Alloc>(chan, static_cast<T&&>(val)),
-                recv_(static_cast<R2&&>(recv)) {}
+            type(C* chan, T&& val, R2&& recv):
+                snd_ops_base<T, C>(chan, std::addressof(value_), std::addressof(value_) + 1),
+                value_(static_cast<T&&>(val)), recv_(static_cast<R2&&>(recv)) {}
             // clang-format on
 
             void set_value() noexcept override { exec::set_value(static_cast<R&&>(recv_)); }
@@ -329,28 +539,66 @@ namespace clu::async
             void set_stopped() noexcept override { exec::set_stopped(static_cast<R&&>(recv_)); }
 
         private:
+            T value_;
             CLU_NO_UNIQUE_ADDRESS R recv_;
 
             friend void tag_invoke(exec::start_t, type& self) noexcept { self.enqueue(); }
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc, typename R>
+        template <typename T, typename C, typename R>
+        struct snd_many_ops_t_
+        {
+            class type;
+        };
+
+        template <typename T, typename C, typename R>
+        using snd_many_ops_t = typename snd_many_ops_t_<T, C, std::decay_t<R>>::type;
+
+        template <typename T, typename C, typename R>
+        class snd_many_ops_t_<T, C, R>::type final : public snd_ops_base<T, C>
+        {
+        public:
+            // clang-format off
+            template <typename R2>
+            type(C* chan, std::vector<T>&& values, R2&& recv):
+                snd_ops_base<T, C>(chan, values.data(), values.data() + values.size()),
+                values_(std::move(values)), recv_(static_cast<R2&&>(recv)) {}
+            // clang-format on
+
+            void set_value() noexcept override { exec::set_value(static_cast<R&&>(recv_)); }
+            void set_error() noexcept override { exec::set_error(static_cast<R&&>(recv_), std::current_exception()); }
+            void set_stopped() noexcept override { exec::set_stopped(static_cast<R&&>(recv_)); }
+
+        private:
+            std::vector<T> values_; // Moving a vector keeps the pointers into it valid
+            CLU_NO_UNIQUE_ADDRESS R recv_;
+
+            friend void tag_invoke(exec::start_t, type& self) noexcept
+            {
+                if (self.values_.empty())
+                    self.set_value();
+                else
+                    self.enqueue();
+            }
+        };
+
+        template <typename T, typename C, typename R>
         struct recv_ops_t_
         {
             class type;
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc, typename R>
-        using recv_ops_t = typename recv_ops_t_<T, P, Alloc, std::decay_t<R>>::type;
+        template <typename T, typename C, typename R>
+        using recv_ops_t = typename recv_ops_t_<T, C, std::decay_t<R>>::type;
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc, typename R>
-        class recv_ops_t_<T, P, Alloc, R>::type final : public recv_ops_base<T, P, Alloc>
+        template <typename T, typename C, typename R>
+        class recv_ops_t_<T, C, R>::type final : public recv_ops_base<T, C>
         {
         public:
             // clang-format off
             template <typename R2>
-            type(channel<T, P, Alloc>* chan, R2&& recv):
-                recv_ops_base<T, P, Alloc>(chan),
+            type(C* chan, R2&& recv):
+                recv_ops_base<T, C>(chan),
                 recv_(static_cast<R2&&>(recv)) {}
             // clang-format on
 
@@ -368,24 +616,94 @@ namespace clu::async
             friend void tag_invoke(exec::start_t, type& self) noexcept { self.enqueue(); }
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
+        template <typename T, typename C, typename R>
+        struct recv_many_ops_t_
+        {
+            class type;
+        };
+
+        template <typename T, typename C, typename R>
+        using recv_many_ops_t = typename recv_many_ops_t_<T, C, std::decay_t<R>>::type;
+
+        template <typename T, typename C, typename R>
+        class recv_many_ops_t_<T, C, R>::type final : public recv_ops_base<T, C>
+        {
+        public:
+            // clang-format off
+            template <typename R2>
+            type(C* chan, const std::size_t max, R2&& recv):
+                recv_ops_base<T, C>(chan),
+                max_(max), recv_(static_cast<R2&&>(recv)) {}
+            // clang-format on
+
+            // Woken up with the first value, take whatever else is there along with it
+            void set_value(T&& value) noexcept override
+            {
+                try
+                {
+                    values_.push_back(static_cast<T&&>(value));
+                    receive_more();
+                }
+                catch (...)
+                {
+                    set_error();
+                    return;
+                }
+                exec::set_value(static_cast<R&&>(recv_), std::move(values_));
+            }
+
+            void set_error() noexcept override { exec::set_error(static_cast<R&&>(recv_), std::current_exception()); }
+            void set_stopped() noexcept override { exec::set_stopped(static_cast<R&&>(recv_)); }
+
+        private:
+            std::size_t max_;
+            std::vector<T> values_;
+            CLU_NO_UNIQUE_ADDRESS R recv_;
+
+            // The capacity is reserved beforehand, so pushing does not allocate
+            void receive_more()
+            {
+                (void)this->receive_into(max_ - values_.size(),
+                    [&](T&& value) { values_.push_back(static_cast<T&&>(value)); });
+            }
+
+            friend void tag_invoke(exec::start_t, type& self) noexcept
+            {
+                try
+                {
+                    self.values_.reserve(self.max_);
+                    self.receive_more();
+                }
+                catch (...)
+                {
+                    self.set_error();
+                    return;
+                }
+                if (self.values_.empty()) // Nothing yet, wait for the first value
+                    self.enqueue();
+                else
+                    exec::set_value(static_cast<R&&>(self.recv_), std::move(self.values_));
+            }
+        };
+
+        template <typename T, typename C>
         struct snd_snd_t_
         {
             class type;
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
-        using snd_snd_t = typename snd_snd_t_<T, P, Alloc>::type;
+        template <typename T, typename C>
+        using snd_snd_t = typename snd_snd_t_<T, C>::type;
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
-        class snd_snd_t_<T, P, Alloc>::type
+        template <typename T, typename C>
+        class snd_snd_t_<T, C>::type
         {
         public:
             using is_sender = void;
 
             // clang-format off
             template <forwarding<T> U>
-            explicit type(channel<T, P, Alloc>* chan, U&& value) noexcept:
+            explicit type(C* chan, U&& value) noexcept:
                 chnl_(chan), value_(static_cast<U&&>(value)) {}
             // clang-format on
 
@@ -393,44 +711,107 @@ namespace clu::async
                 exec::set_value_t(), exec::set_error_t(std::exception_ptr), exec::set_stopped_t()>;
 
         private:
-            channel<T, P, Alloc>* chnl_;
+            C* chnl_;
             T value_;
 
             template <typename R>
             friend auto tag_invoke(exec::connect_t, type&& self, R&& recv)
             {
-                return snd_ops_t<T, P, Alloc, R>( //
+                return snd_ops_t<T, C, R>( //
                     self.chnl_, static_cast<T&&>(self.value_), static_cast<R&&>(recv));
             }
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
+        template <typename T, typename C>
         struct recv_snd_t_
         {
             class type;
         };
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
-        using recv_snd_t = typename recv_snd_t_<T, P, Alloc>::type;
+        template <typename T, typename C>
+        using recv_snd_t = typename recv_snd_t_<T, C>::type;
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
-        class recv_snd_t_<T, P, Alloc>::type
+        template <typename T, typename C>
+        class recv_snd_t_<T, C>::type
         {
         public:
             using is_sender = void;
 
-            explicit type(channel<T, P, Alloc>* chan) noexcept: chnl_(chan) {}
+            explicit type(C* chan) noexcept: chnl_(chan) {}
 
             using completion_signatures = exec::completion_signatures< //
                 exec::set_value_t(T), exec::set_error_t(std::exception_ptr), exec::set_stopped_t()>;
 
         private:
-            channel<T, P, Alloc>* chnl_;
+            C* chnl_;
+
+            template <typename R>
+            friend auto tag_invoke(exec::connect_t, type&& self, R&& recv)
+            {
+                return recv_ops_t<T, C, R>(self.chnl_, static_cast<R&&>(recv));
+            }
+        };
+
+        template <typename T, typename C>
+        struct snd_many_snd_t_
+        {
+            class type;
+        };
+
+        template <typename T, typename C>
+        using snd_many_snd_t = typename snd_many_snd_t_<T, C>::type;
+
+        template <typename T, typename C>
+        class snd_many_snd_t_<T, C>::type
+        {
+        public:
+            using is_sender = void;
+
+            type(C* chan, std::vector<T>&& values) noexcept: chnl_(chan), values_(std::move(values)) {}
+
+            using completion_signatures = exec::completion_signatures< //
+                exec::set_value_t(), exec::set_error_t(std::exception_ptr), exec::set_stopped_t()>;
+
+        private:
+            C* chnl_;
+            std::vector<T> values_;
+
+            template <typename R>
+            friend auto tag_invoke(exec::connect_t, type&& self, R&& recv)
+            {
+                return snd_many_ops_t<T, C, R>( //
+                    self.chnl_, std::move(self.values_), static_cast<R&&>(recv));
+            }
+        };
+
+        template <typename T, typename C>
+        struct recv_many_snd_t_
+        {
+            class type;
+        };
+
+        template <typename T, typename C>
+        using recv_many_snd_t = typename recv_many_snd_t_<T, C>::type;
+
+        template <typename T, typename C>
+        class recv_many_snd_t_<T, C>::type
+        {
+        public:
+            using is_sender = void;
+
+            type(C* chan, const std::size_t max) noexcept: chnl_(chan), max_(max) {}
+
+            using completion_signatures = exec::completion_signatures< //
+                exec::set_value_t(std::vector<T>), exec::set_error_t(std::exception_ptr), exec::set_stopped_t()>;
+
+        private:
+            C* chnl_;
+            std::size_t max_;
 
             template <typename R>
             friend auto tag_invoke(exec::connect_t, type&& self, R&& recv)
             {
-                return recv_ops_t<T, P, Alloc, R>(self.chnl_, static_cast<R&&>(recv));
+                return recv_many_ops_t<T, C, R>(self.chnl_, self.max_, static_cast<R&&>(recv));
             }
         };
     } // namespace detail::chnl
@@ -455,10 +836,13 @@ namespace clu::async
         {
             std::unique_lock lck(mtx_);
             // Dequeue a pending receiving operation, if there is any
-            if (auto* ptr = recv_queue_.pop())
+            if (auto* ptr = this->pop_receiver())
             {
                 lck.unlock();
-                ptr->set_value(static_cast<U&&>(value));
+                if constexpr (std::is_lvalue_reference_v<U>)
+                    ptr->set_value(T(value)); // Receivers take rvalues, make a copy
+                else
+                    ptr->set_value(static_cast<U&&>(value));
                 return true;
             }
             if constexpr (!push_never_suspends)
@@ -471,10 +855,23 @@ namespace clu::async
         template <forwarding<T> U>
         [[nodiscard]] auto send_async(U&& value)
         {
-            return detail::chnl::snd_snd_t<T, P, Alloc>( //
+            return detail::chnl::snd_snd_t<T, channel>( //
                 this, static_cast<U&&>(value));
         }
 
+        /// Sends a batch of values, which will not be interleaved with values from other sending operations.
+        template <std::ranges::input_range R>
+            requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+        [[nodiscard]] auto send_many(R&& values)
+        {
+            std::vector<T> vec;
+            if constexpr (std::ranges::sized_range<R>)
+                vec.reserve(std::ranges::size(values));
+            for (auto&& value : values)
+                vec.emplace_back(static_cast<decltype(value)&&>(value));
+            return detail::chnl::snd_many_snd_t<T, channel>(this, std::move(vec));
+        }
+
         std::optional<T> try_receive()
         {
             std::unique_lock lck(mtx_);
@@ -482,29 +879,41 @@ namespace clu::async
             if (buffer_.can_pop())
             {
                 T value = buffer_.pop();
-                // Dequeue a sending operation, buffer should be "can_push" since we just popped from it
-                if (auto* ptr = snd_queue_.pop())
-                    this->push_buffer_release_lock(ptr, lck);
-                return std::move(value); // Not pessimization! The return type is optional<T>
-            }
-            // Nothing in the buffer, dequeue a pending sending operation, if there is any
-            if (auto* ptr = snd_queue_.pop())
-            {
-                lck.unlock();
-                scope_exit guard{[=] { ptr->set_value(); }}; // Guard against throwing moves
-                return std::move(ptr->value);
+                // Move values from pending sending operations into the space we've just made
+                this->fill_buffer_release_lock(lck);
+                return std::optional<T>(std::move(value));
             }
-            return std::nullopt;
+            // Nothing in the buffer, take a value from a pending sending operation, if there is any
+            std::optional<T> result;
+            if (snd_queue_.peek())
+                this->take_from_sender_release_lock(lck, [&](T&& value) { result.emplace(static_cast<T&&>(value)); });
+            return result;
         }
 
-        [[nodiscard]] auto receive_async() { return detail::chnl::recv_snd_t<T, P, Alloc>(this); }
+        /// Receives up to out.size() values without waiting, returns the number of values received.
+        std::size_t try_receive_many(const std::span<T> out)
+        {
+            return this->receive_into(out.size(), [iter = out.begin()](T&& value) mutable
+                { *iter++ = static_cast<T&&>(value); });
+        }
+
+        [[nodiscard]] auto receive_async() { return detail::chnl::recv_snd_t<T, channel>(this); }
+
+        /// Receives at least one and at most max values, the sender completes with a std::vector<T>.
+        [[nodiscard]] auto receive_many(const std::size_t max)
+        {
+            CLU_ASSERT(max != 0, "receive_many must be able to receive at least one value");
+            return detail::chnl::recv_many_snd_t<T, channel>(this, max);
+        }
 
         void cancel() noexcept
         {
             std::unique_lock lck(mtx_);
             buffer_.clear();
             auto sndq = std::move(snd_queue_);
-            auto recvq = std::move(recv_queue_);
+            detail::chnl::intrusive_queue<recv_ops_base> recvq;
+            while (auto* ptr = this->pop_receiver())
+                recvq.push(*ptr);
             lck.unlock(); // Avoid calling arbitrary callback (set_stopped) while holding the lock
             while (auto* ptr = sndq.pop())
                 ptr->set_stopped();
@@ -513,8 +922,8 @@ namespace clu::async
         }
 
     private:
-        using snd_ops_base = detail::chnl::snd_ops_base<T, P, Alloc>;
-        using recv_ops_base = detail::chnl::recv_ops_base<T, P, Alloc>;
+        using snd_ops_base = detail::chnl::snd_ops_base<T, channel>;
+        using recv_ops_base = detail::chnl::recv_ops_base<T, channel>;
         friend snd_ops_base;
         friend recv_ops_base;
 
@@ -528,27 +937,39 @@ namespace clu::async
         void enqueue_snd_ops(snd_ops_base* ops) noexcept
         {
             std::unique_lock lck(mtx_);
-            // Dequeue a pending receiving operation, if there is any
-            if (auto* ptr = recv_queue_.pop())
+            // Always go through the queue, so that values from a batch are not interleaved with others
+            snd_queue_.push(*ops);
+            // Hand values over to pending receiving operations, if there are any the buffer must be empty
+            while (auto* ptr = this->pop_receiver())
             {
-                lck.unlock();
-                ptr->set_value(std::move(ops->value));
-                ops->set_value();
-                return;
-            }
-            if constexpr (!push_never_suspends)
-                if (!buffer_.can_push()) // Buffer is full, enqueue this operation
+                const snd_ops_base* front = snd_queue_.peek();
+                const bool more = front->next || front->last - front->first > 1;
+                try
                 {
-                    snd_queue_.push(ops);
-                    return;
+                    this->take_from_sender_release_lock(
+                        lck, [=](T&& value) noexcept { ptr->set_value(static_cast<T&&>(value)); });
                 }
-            // Save the value into the buffer
-            this->push_buffer_release_lock(ops, lck);
+                catch (...)
+                {
+                    lck.unlock();
+                    ptr->set_error();
+                }
+                if (!more)
+                    return;
+                lck.lock();
+                if (!snd_queue_.peek()) // Others have taken the rest of the values
+                    return;
+            }
+            // Save the rest of the values into the buffer
+            this->fill_buffer_release_lock(lck);
         }
 
         void enqueue_recv_ops(recv_ops_base* ops) noexcept
         {
             std::unique_lock lck(mtx_);
+            // There is a value for this operation, but it may have been completed by another channel
+            if ((buffer_.can_pop() || snd_queue_.peek()) && !ops->try_claim())
+                return;
             // Pop a value from the buffer, if there is any
             if (buffer_.can_pop())
             {
@@ -557,9 +978,8 @@ namespace clu::async
                 {
                     T value = buffer_.pop();
                     // noexcept from now on
-                    // Dequeue a sending operation, buffer should be "can_push" since we just popped from it
-                    if (auto* ptr = snd_queue_.pop())
-                        this->push_buffer_release_lock(ptr, lck);
+                    // Move values from pending sending operations into the space we've just made
+                    this->fill_buffer_release_lock(lck);
                     ops->set_value(std::move(value));
                 }
                 catch (...)
@@ -568,34 +988,123 @@ namespace clu::async
                     ops->set_error();
                 }
             }
-            // Nothing in the buffer, dequeue a pending sending operation, if there is any
-            else if (auto* ptr = snd_queue_.pop())
+            // Nothing in the buffer, take a value from a pending sending operation, if there is any
+            else if (snd_queue_.peek())
             {
-                lck.unlock();
-                ops->set_value(std::move(ptr->value));
-                ptr->set_value();
-                return;
+                try
+                {
+                    this->take_from_sender_release_lock(
+                        lck, [=](T&& value) noexcept { ops->set_value(static_cast<T&&>(value)); });
+                }
+                catch (...)
+                {
+                    lck.unlock();
+                    ops->set_error();
+                }
             }
             // We can only wait now, enqueue this operation
             else
-                recv_queue_.push(ops);
+                recv_queue_.push(*ops);
         }
 
-        void push_buffer_release_lock(snd_ops_base* ops, std::unique_lock<std::mutex>& lck) noexcept
+        void dequeue_recv_ops(recv_ops_base* ops) noexcept
         {
-            // Try pushing, propagation through the operation state on any error
-            try
-            {
-                buffer_.push(P{}, std::move(ops->value));
-            }
-            catch (...)
+            std::unique_lock lck(mtx_);
+            (void)recv_queue_.remove(ops);
+        }
+
+        // Dequeues the first pending receiving operation which can still be completed
+        recv_ops_base* pop_receiver() noexcept
+        {
+            while (auto* ptr = recv_queue_.pop())
+                if (ptr->try_claim())
+                    return ptr;
+            return nullptr;
+        }
+
+        // Feeds the next value of the first pending sending operation into func, releases the lock
+        template <typename F>
+        void take_from_sender_release_lock(std::unique_lock<std::mutex>& lck, F&& func)
+        {
+            snd_ops_base* ops = snd_queue_.peek();
+            if (ops->last - ops->first == 1)
             {
+                // The last value, the sending operation is kept alive until we complete it
+                (void)snd_queue_.pop();
                 lck.unlock();
-                ops->set_error();
+                scope_exit guard{[=] { ops->set_value(); }}; // Guard against throwing moves
+                func(static_cast<T&&>(*ops->first));
                 return;
             }
+            // Someone else may finish the operation once we release the lock, move the value out first
+            T value = static_cast<T&&>(*ops->first);
+            ++ops->first;
+            lck.unlock();
+            func(static_cast<T&&>(value));
+        }
+
+        // Moves values from pending sending operations into the buffer while there is room, releases the lock
+        void fill_buffer_release_lock(std::unique_lock<std::mutex>& lck) noexcept
+        {
+            detail::chnl::intrusive_queue<snd_ops_base> done;
+            while (auto* ptr = snd_queue_.peek())
+            {
+                if constexpr (!push_never_suspends)
+                    if (!buffer_.can_push())
+                        break;
+                // Try pushing, propagation through the operation state on any error
+                try
+                {
+                    buffer_.push(P{}, std::move(*ptr->first));
+                }
+                catch (...)
+                {
+                    (void)snd_queue_.pop();
+                    lck.unlock();
+                    ptr->set_error();
+                    lck.lock();
+                    continue;
+                }
+                if (++ptr->first == ptr->last)
+                {
+                    (void)snd_queue_.pop();
+                    done.push(*ptr);
+                }
+            }
             lck.unlock();
-            ops->set_value();
+            while (auto* ptr = done.pop())
+                ptr->set_value();
+        }
+
+        template <typename F>
+        std::size_t receive_into(const std::size_t max, F&& sink)
+        {
+            detail::chnl::intrusive_queue<snd_ops_base> done;
+            scope_exit guard{[&]
+                {
+                    while (auto* ptr = done.pop())
+                        ptr->set_value();
+                }}; // Completes the finished sending operations after the lock is released
+            std::unique_lock lck(mtx_);
+            std::size_t count = 0;
+            for (; count < max; count++)
+            {
+                if (buffer_.can_pop())
+                    sink(buffer_.pop());
+                else if (auto* ptr = snd_queue_.peek())
+                {
+                    sink(std::move(*ptr->first));
+                    if (++ptr->first == ptr->last)
+                    {
+                        (void)snd_queue_.pop();
+                        done.push(*ptr);
+                    }
+                }
+                else
+                    break;
+            }
+            this->fill_buffer_release_lock(lck);
+            return count;
         }
     };
 
@@ -609,16 +1118,224 @@ namespace clu::async
 
     namespace detail::chnl
     {
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
-        void snd_ops_base<T, P, Alloc>::enqueue() noexcept
+        // Channel over a lock-free ring. Values go through the ring without locking, the mutex only
+        // guards the queues of suspended operations, so it is only touched when the ring is full or
+        // empty, or when the other side has someone waiting.
+        template <typename T, typename Ring, buffer_overflow_policy P>
+        class lockfree_channel
         {
-            chnl_->enqueue_snd_ops(this);
-        }
+        public:
+            static_assert(std::is_nothrow_move_constructible_v<T>,
+                "lock-free channels require the value type to be nothrow move constructible");
+            static_assert(Ring::multi_consumer || !std::is_same_v<P, bop::drop_oldest_t>,
+                "the \"drop_oldest\" policy needs the sender to pop from the ring, "
+                "which is not possible with a single consumer ring");
+
+            explicit lockfree_channel(const std::size_t buffer_size, const typename Ring::allocator_type alloc = {}):
+                ring_(buffer_size, alloc)
+            {
+                CLU_ASSERT(buffer_size != 0 && buffer_size != unbounded,
+                    "lock-free channels only support fixed non-zero buffer sizes");
+            }
 
-        template <typename T, buffer_overflow_policy P, allocator Alloc>
-        void recv_ops_base<T, P, Alloc>::enqueue() noexcept
-        {
-            chnl_->enqueue_recv_ops(this);
-        }
+            ~lockfree_channel() noexcept { cancel(); }
+
+            template <forwarding<T> U>
+            bool try_send(U&& value)
+            {
+                if constexpr (!std::is_nothrow_constructible_v<T, U>)
+                    return this->try_send(T(static_cast<U&&>(value)));
+                else
+                {
+                    if (!this->push(static_cast<U&&>(value)))
+                        return false;
+                    wake_receiver();
+                    return true;
+                }
+            }
+
+            template <forwarding<T> U>
+            [[nodiscard]] auto send_async(U&& value)
+            {
+                return snd_snd_t<T, lockfree_channel>(this, static_cast<U&&>(value));
+            }
+
+            std::optional<T> try_receive() noexcept
+            {
+                std::optional<T> value = ring_.try_pop();
+                if constexpr (!push_never_suspends)
+                    if (value)
+                        wake_sender();
+                return value;
+            }
+
+            [[nodiscard]] auto receive_async() { return recv_snd_t<T, lockfree_channel>(this); }
+
+            // Note that draining the ring counts as a receive operation, for a single-consumer channel
+            // this should not be called concurrently with other receives
+            void cancel() noexcept
+            {
+                std::unique_lock lck(mtx_);
+                ring_.clear();
+                auto sndq = std::move(snd_queue_);
+                auto recvq = std::move(recv_queue_);
+                snd_waiters_.store(0, std::memory_order::relaxed);
+                recv_waiters_.store(0, std::memory_order::relaxed);
+                lck.unlock();
+                while (auto* ptr = sndq.pop())
+                    ptr->set_stopped();
+                while (auto* ptr = recvq.pop())
+                    ptr->set_stopped();
+            }
+
+        private:
+            using snd_ops_base = chnl::snd_ops_base<T, lockfree_channel>;
+            using recv_ops_base = chnl::recv_ops_base<T, lockfree_channel>;
+            friend snd_ops_base;
+            friend recv_ops_base;
+
+            static constexpr bool push_never_suspends = !std::is_same_v<P, bop::suspend_t>;
+
+            Ring ring_;
+            // The waiter counts are only modified with the mutex held, but they are read without locking
+            // by the fast paths to decide whether the other side needs waking up
+            alignas(clu::detail::cache_line_size) std::atomic_size_t snd_waiters_ = 0;
+            std::atomic_size_t recv_waiters_ = 0;
+            std::mutex mtx_;
+            intrusive_queue<snd_ops_base> snd_queue_;
+            intrusive_queue<recv_ops_base> recv_queue_;
+
+            // Push into the ring according to the overflow policy, returns false if a suspending push
+            // should wait for room in the ring
+            template <typename U>
+            bool push(U&& value) noexcept
+            {
+                if constexpr (std::is_same_v<P, bop::drop_oldest_t>)
+                {
+                    while (!ring_.try_push(static_cast<U&&>(value)))
+                        (void)ring_.try_pop(); // Make room by discarding the oldest value
+                    return true;
+                }
+                else if constexpr (std::is_same_v<P, bop::drop_latest_t>)
+                {
+                    // The other end of the ring is owned by the consumers, so instead of overwriting
+                    // the newest buffered value we drop the one being sent
+                    (void)ring_.try_push(static_cast<U&&>(value));
+                    return true;
+                }
+                else
+                    return ring_.try_push(static_cast<U&&>(value));
+            }
+
+            void enqueue_snd_ops(snd_ops_base* ops) noexcept
+            {
+                if (!this->push(std::move(*ops->first)))
+                {
+                    std::unique_lock lck(mtx_);
+                    snd_waiters_.fetch_add(1, std::memory_order::relaxed);
+                    // Pairs with the fence in wake_sender, either we see the room made by the receiver,
+                    // or the receiver sees us waiting
+                    std::atomic_thread_fence(std::memory_order::seq_cst);
+                    if (!ring_.try_push(std::move(*ops->first)))
+                    {
+                        snd_queue_.push(*ops);
+                        return;
+                    }
+                    snd_waiters_.fetch_sub(1, std::memory_order::relaxed);
+                }
+                wake_receiver();
+                ops->set_value();
+            }
+
+            void enqueue_recv_ops(recv_ops_base* ops) noexcept
+            {
+                std::optional<T> value = ring_.try_pop();
+                if (!value)
+                {
+                    std::unique_lock lck(mtx_);
+                    recv_waiters_.fetch_add(1, std::memory_order::relaxed);
+                    std::atomic_thread_fence(std::memory_order::seq_cst); // Pairs with the one in wake_receiver
+                    value = ring_.try_pop();
+                    if (!value)
+                    {
+                        recv_queue_.push(*ops);
+                        return;
+                    }
+                    recv_waiters_.fetch_sub(1, std::memory_order::relaxed);
+                }
+                if constexpr (!push_never_suspends)
+                    wake_sender();
+                ops->set_value(*std::move(value));
+            }
+
+            // Called after pushing into the ring, hands a value over to a suspended receiver if there is one
+            void wake_receiver() noexcept
+            {
+                std::atomic_thread_fence(std::memory_order::seq_cst);
+                if (recv_waiters_.load(std::memory_order::relaxed) == 0)
+                    return;
+                std::unique_lock lck(mtx_);
+                recv_ops_base* ops = recv_queue_.peek();
+                if (!ops)
+                    return;
+                // Someone else may have taken the value, in that case the waiter
+                // stays in the queue and will be woken up by the next push
+                std::optional<T> value = ring_.try_pop();
+                if (!value)
+                    return;
+                (void)recv_queue_.pop();
+                recv_waiters_.fetch_sub(1, std::memory_order::relaxed);
+                lck.unlock();
+                if constexpr (!push_never_suspends)
+                    wake_sender();
+                ops->set_value(*std::move(value));
+            }
+
+            // Called after popping from the ring, moves the value of a suspended sender into the ring
+            void wake_sender() noexcept
+            {
+                std::atomic_thread_fence(std::memory_order::seq_cst);
+                if (snd_waiters_.load(std::memory_order::relaxed) == 0)
+                    return;
+                std::unique_lock lck(mtx_);
+                snd_ops_base* ops = snd_queue_.peek();
+                if (!ops || !ring_.try_push(std::move(*ops->first)))
+                    return;
+                (void)snd_queue_.pop();
+                snd_waiters_.fetch_sub(1, std::memory_order::relaxed);
+                lck.unlock();
+                wake_receiver();
+                ops->set_value();
+            }
+        };
     } // namespace detail::chnl
+
+    /// Channel over a lock-free single-producer single-consumer ring. Sending operations must not
+    /// overlap with each other, neither may receiving operations.
+    template <movable_value T, //
+        buffer_overflow_policy P = buffer_overflow_policies::suspend_t, //
+        allocator Alloc = std::allocator<T>>
+    using spsc_channel = detail::chnl::lockfree_channel<T, detail::chnl::spsc_ring<T, Alloc>, P>;
+
+    /// Channel over a lock-free bounded multi-producer multi-consumer ring.
+    template <movable_value T, //
+        buffer_overflow_policy P = buffer_overflow_policies::suspend_t, //
+        allocator Alloc = std::allocator<T>>
+    using mpmc_channel = detail::chnl::lockfree_channel<T, detail::chnl::mpmc_ring<T, Alloc>, P>;
+
+    template <movable_value T, //
+        buffer_overflow_policy P = buffer_overflow_policies::suspend_t, //
+        allocator Alloc = std::allocator<T>>
+    auto make_spsc_channel(const std::size_t buffer_size, P = P{}, const Alloc alloc = Alloc{})
+    {
+        return spsc_channel<T, P, Alloc>(buffer_size, alloc);
+    }
+
+    template <movable_value T, //
+        buffer_overflow_policy P = buffer_overflow_policies::suspend_t, //
+        allocator Alloc = std::allocator<T>>
+    auto make_mpmc_channel(const std::size_t buffer_size, P = P{}, const Alloc alloc = Alloc{})
+    {
+        return mpmc_channel<T, P, Alloc>(buffer_size, alloc);
+    }
 } // namespace clu::async
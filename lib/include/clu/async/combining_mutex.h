@@ -0,0 +1,166 @@
+#pragma once
+
+#include <functional>
+#include <variant>
+
+#include "../execution/execution_traits.h"
+
+namespace clu::async
+{
+    class combining_mutex;
+
+    namespace detail::cmb_mtx
+    {
+        class ops_base
+        {
+        public:
+            ops_base* next = nullptr;
+
+            ops_base() noexcept = default;
+            CLU_IMMOVABLE_TYPE(ops_base);
+            virtual void execute() noexcept = 0; ///< Runs the critical section, called by the lock holder.
+            virtual void complete() noexcept = 0; ///< Completes the operation with the result of execute().
+
+        protected:
+            ~ops_base() noexcept = default;
+        };
+
+        template <typename F, typename R>
+        struct ops_t_
+        {
+            class type;
+        };
+
+        template <typename F, typename R>
+        using ops_t = typename ops_t_<F, std::decay_t<R>>::type;
+
+        template <typename F, typename R>
+        class ops_t_<F, R>::type final : public ops_base
+        {
+        public:
+            // clang-format off
+            template <typename F2, typename R2>
+            type(combining_mutex* mut, F2&& func, R2&& recv):
+                mut_(mut), func_(static_cast<F2&&>(func)), recv_(static_cast<R2&&>(recv)) {}
+            // clang-format on
+
+            void execute() noexcept override
+            {
+                try
+                {
+                    if constexpr (std::is_void_v<result_t>)
+                    {
+                        std::invoke(static_cast<F&&>(func_));
+                        result_.template emplace<1>();
+                    }
+                    else
+                        result_.template emplace<1>(std::invoke(static_cast<F&&>(func_)));
+                }
+                catch (...)
+                {
+                    result_.template emplace<2>(std::current_exception());
+                }
+            }
+
+            void complete() noexcept override
+            {
+                if (result_.index() == 2)
+                    exec::set_error(static_cast<R&&>(recv_), std::get<2>(std::move(result_)));
+                else if constexpr (std::is_void_v<result_t>)
+                    exec::set_value(static_cast<R&&>(recv_));
+                else
+                    exec::set_value(static_cast<R&&>(recv_), std::get<1>(std::move(result_)));
+            }
+
+        private:
+            using result_t = call_result_t<F>;
+            using value_t = conditional_t<std::is_void_v<result_t>, std::monostate, result_t>;
+
+            combining_mutex* mut_;
+            F func_;
+            CLU_NO_UNIQUE_ADDRESS R recv_;
+            std::variant<std::monostate, value_t, std::exception_ptr> result_;
+
+            friend void tag_invoke(exec::start_t, type& self) noexcept { start_ops(*self.mut_, self); }
+        };
+
+        template <typename F>
+        struct snd_t_
+        {
+            class type;
+        };
+
+        template <typename F>
+        using snd_t = typename snd_t_<F>::type;
+
+        template <typename F>
+        class snd_t_<F>::type
+        {
+        public:
+            using is_sender = void;
+            using completion_signatures = exec::completion_signatures< //
+                exec::detail::comp_sig_of_single<call_result_t<F>>, exec::set_error_t(std::exception_ptr)>;
+
+            // clang-format off
+            template <typename F2>
+            type(combining_mutex* mut, F2&& func): mut_(mut), func_(static_cast<F2&&>(func)) {}
+            // clang-format on
+
+        private:
+            combining_mutex* mut_;
+            F func_;
+
+            template <typename R>
+            friend auto tag_invoke(exec::connect_t, type&& self, R&& recv)
+            {
+                return ops_t<F, R>(self.mut_, static_cast<F&&>(self.func_), static_cast<R&&>(recv));
+            }
+
+            template <typename R>
+                requires std::copy_constructible<F>
+            friend auto tag_invoke(exec::connect_t, const type& self, R&& recv)
+            {
+                return ops_t<F, R>(self.mut_, self.func_, static_cast<R&&>(recv));
+            }
+        };
+    } // namespace detail::cmb_mtx
+
+    /**
+     * \brief A flat combining mutex.
+     * \details Instead of resuming the waiters one by one, the current holder of the lock executes the
+     * critical sections queued by the waiters in a batch on its own thread, so that the protected data
+     * stays in one cache. The waiters are completed with their results after the lock is released, or
+     * every max_combine critical sections if the lock holder keeps finding new waiters.
+     */
+    class combining_mutex
+    {
+    public:
+        /// Maximum number of executed critical sections whose operations are not completed yet.
+        static constexpr std::size_t max_combine = 64;
+
+        combining_mutex() noexcept = default;
+        CLU_IMMOVABLE_TYPE(combining_mutex);
+
+        /**
+         * \brief Runs a critical section with the lock held.
+         * \param func The critical section, which may be executed on the thread of another waiter.
+         * \return A sender which completes with the result of func, or with an exception_ptr if func throws.
+         */
+        template <typename F>
+            requires std::invocable<std::decay_t<F>&&>
+        [[nodiscard]] auto run(F&& func)
+        {
+            return detail::cmb_mtx::snd_t<std::decay_t<F>>(this, static_cast<F&&>(func));
+        }
+
+    private:
+        using ops_base = detail::cmb_mtx::ops_base;
+
+        // Stores this when the mutex is not held, stores the latest waiting
+        // operation state (or nullptr) otherwise
+        std::atomic<void*> waiting_{this};
+
+        friend void start_ops(combining_mutex& self, ops_base& ops) noexcept;
+        void combine(ops_base& first) noexcept;
+    };
+} // namespace clu::async
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <mutex>
+#include <optional>
+
+#include "../execution/execution_traits.h"
+#include "../concurrency.h"
+#include "../copy_elider.h"
+#include "../manual_lifetime.h"
+
+namespace clu::async
+{
+    template <exec::time_scheduler S>
+    class rate_limiter;
+
+    namespace detail::rtlm
+    {
+        class ops_base
+        {
+        public:
+            std::size_t count = 0;
+            ops_base* next = nullptr;
+
+            explicit ops_base(const std::size_t n) noexcept: count(n) {}
+            CLU_IMMOVABLE_TYPE(ops_base);
+            virtual void set_value() noexcept = 0;
+            virtual void set_error(std::exception_ptr ptr) noexcept = 0;
+
+        protected:
+            ~ops_base() noexcept = default;
+        };
+
+        template <typename L, typename R>
+        struct ops_t_
+        {
+            class type;
+        };
+
+        template <typename L, typename R>
+        using ops_t = typename ops_t_<L, std::decay_t<R>>::type;
+
+        template <typename L, typename R>
+        class ops_t_<L, R>::type final : public ops_base
+        {
+        public:
+            // clang-format off
+            template <typename R2>
+            type(L* limiter, const std::size_t n, R2&& recv):
+                ops_base(n), limiter_(limiter), recv_(static_cast<R2&&>(recv)) {}
+            // clang-format on
+
+            void set_value() noexcept override { exec::set_value(static_cast<R&&>(recv_)); }
+            void set_error(std::exception_ptr ptr) noexcept override
+            {
+                exec::set_error(static_cast<R&&>(recv_), std::move(ptr));
+            }
+
+        private:
+            L* limiter_;
+            CLU_NO_UNIQUE_ADDRESS R recv_;
+
+            friend void tag_invoke(exec::start_t, type& self) noexcept
+            {
+                if (!start_ops(*self.limiter_, self)) // Acquired synchronously
+                    self.set_value();
+            }
+        };
+
+        template <typename L>
+        class snd_t
+        {
+        public:
+            using is_sender = void;
+            using completion_signatures = exec::completion_signatures< //
+                exec::set_value_t(), exec::set_error_t(std::exception_ptr)>;
+
+            explicit snd_t(L* limiter, const std::size_t n) noexcept: limiter_(limiter), n_(n) {}
+
+        private:
+            L* limiter_;
+            std::size_t n_;
+
+            template <typename R>
+            friend auto tag_invoke(exec::connect_t, const snd_t self, R&& recv)
+            {
+                return ops_t<L, R>(self.limiter_, self.n_, static_cast<R&&>(recv));
+            }
+        };
+
+        // Receiver of the refill timer
+        template <typename L>
+        class timer_recv
+        {
+        public:
+            using is_receiver = void;
+
+            explicit timer_recv(L* limiter) noexcept: limiter_(limiter) {}
+
+        private:
+            L* limiter_;
+
+            // The timer operation may be destroyed in on_timer, *this must not be touched afterwards
+            void finish(std::exception_ptr ptr) noexcept { limiter_->on_timer(std::move(ptr)); }
+
+            friend void tag_invoke(exec::set_value_t, timer_recv&& self) noexcept { self.finish(nullptr); }
+            friend void tag_invoke(exec::set_error_t, timer_recv&& self, auto&& error) noexcept
+            {
+                self.finish(exec::detail::make_exception_ptr(static_cast<decltype(error)&&>(error)));
+            }
+            friend void tag_invoke(exec::set_stopped_t, timer_recv&& self) noexcept { self.finish(nullptr); }
+        };
+    } // namespace detail::rtlm
+
+    /**
+     * \brief A token bucket rate limiter.
+     * \details The bucket holds at most capacity tokens and gains one token every period. Waiting
+     * operations are resumed in FIFO order by a single timer on the given scheduler, so no thread is
+     * blocked on behalf of the waiters.
+     * \tparam S Type of the time scheduler which drives the refilling, e.g. the scheduler of a
+     * timer_thread_context.
+     */
+    template <exec::time_scheduler S>
+    class rate_limiter
+    {
+    public:
+        using time_point = decltype(exec::now(std::declval<S&>()));
+        using duration = typename time_point::duration;
+
+        /**
+         * \brief Constructs a rate limiter with a full bucket.
+         * \param schd The scheduler to schedule the refilling timer on.
+         * \param capacity Maximum number of tokens in the bucket.
+         * \param period Time it takes to gain one token.
+         */
+        rate_limiter(S schd, const std::size_t capacity, const duration period):
+            schd_(static_cast<S&&>(schd)), capacity_(capacity), period_(period), tokens_(capacity),
+            last_refill_(exec::now(schd_))
+        {
+            CLU_ASSERT(capacity > 0, "The capacity of a rate limiter must be positive");
+            CLU_ASSERT(period > duration::zero(), "The refill period of a rate limiter must be positive");
+        }
+
+        ~rate_limiter() noexcept
+        {
+            CLU_ASSERT(!head_ && !armed_, "A rate limiter is destroyed while there are operations waiting on it");
+            if (timer_constructed_)
+                timer_.destruct();
+        }
+
+        CLU_IMMOVABLE_TYPE(rate_limiter);
+
+        [[nodiscard]] bool try_acquire(const std::size_t n = 1)
+        {
+            std::unique_lock lock(mut_);
+            refill();
+            if (head_ || tokens_ < n) // Don't overtake the waiting operations
+                return false;
+            tokens_ -= n;
+            return true;
+        }
+
+        /**
+         * \brief Acquires n tokens from the bucket.
+         * \return A sender which completes when the tokens are acquired, on the context of the scheduler
+         * if the operation needs to wait.
+         */
+        [[nodiscard]] auto acquire_async(const std::size_t n = 1) noexcept
+        {
+            CLU_ASSERT(n <= capacity_, "Trying to acquire more tokens than the capacity of a rate limiter");
+            return detail::rtlm::snd_t<rate_limiter>(this, n);
+        }
+
+    private:
+        using ops_base = detail::rtlm::ops_base;
+        using timer_recv = detail::rtlm::timer_recv<rate_limiter>;
+        using timer_ops_t = exec::connect_result_t< //
+            decltype(exec::schedule_at(std::declval<S&>(), std::declval<time_point>())), timer_recv>;
+        friend timer_recv;
+
+        S schd_;
+        std::size_t capacity_;
+        duration period_;
+
+        spinlock mut_;
+        std::size_t tokens_;
+        time_point last_refill_;
+        ops_base* head_ = nullptr;
+        ops_base* tail_ = nullptr;
+
+        // Only the thread which sets armed_ touches the timer
+        bool armed_ = false;
+        bool timer_constructed_ = false;
+        manual_lifetime<timer_ops_t> timer_;
+
+        // Adds the tokens gained since the last refill, needs to be called with the lock held
+        void refill()
+        {
+            const time_point now = exec::now(schd_);
+            if (tokens_ == capacity_)
+            {
+                last_refill_ = now; // Tokens don't accumulate when the bucket is full
+                return;
+            }
+            const auto gained = static_cast<std::size_t>((now - last_refill_) / period_);
+            if (gained >= capacity_ - tokens_)
+            {
+                tokens_ = capacity_;
+                last_refill_ = now;
+            }
+            else
+            {
+                tokens_ += gained;
+                last_refill_ += period_ * static_cast<typename duration::rep>(gained);
+            }
+        }
+
+        // Dequeues the waiting operations which can be satisfied, needs to be called with the lock held
+        ops_base* take_satisfied() noexcept
+        {
+            ops_base* first = nullptr;
+            ops_base* last = nullptr;
+            while (head_ && head_->count <= tokens_)
+            {
+                tokens_ -= head_->count;
+                last = std::exchange(head_, head_->next);
+                if (!first)
+                    first = last;
+            }
+            if (last)
+                last->next = nullptr;
+            if (!head_)
+                tail_ = nullptr;
+            return first;
+        }
+
+        // Returns the time point to arm the timer at if it should be armed, needs to be called with the lock held
+        std::optional<time_point> should_arm() noexcept
+        {
+            if (!head_ || armed_)
+                return std::nullopt;
+            armed_ = true;
+            return last_refill_ + period_ * static_cast<typename duration::rep>(head_->count - tokens_);
+        }
+
+        friend bool start_ops(rate_limiter& self, ops_base& ops) noexcept { return self.enqueue(ops); }
+
+        bool enqueue(ops_base& ops) noexcept
+        {
+            std::optional<time_point> arm_at;
+            {
+                std::unique_lock lock(mut_);
+                try
+                {
+                    refill();
+                }
+                catch (...)
+                {
+                    lock.unlock();
+                    ops.set_error(std::current_exception());
+                    return true;
+                }
+                if (!head_ && tokens_ >= ops.count)
+                {
+                    tokens_ -= ops.count;
+                    return false; // Acquired synchronously
+                }
+                ops.next = nullptr;
+                if (tail_)
+                    tail_->next = &ops;
+                else
+                    head_ = &ops;
+                tail_ = &ops;
+                arm_at = should_arm();
+            }
+            if (arm_at)
+                arm(*arm_at);
+            return true;
+        }
+
+        void arm(const time_point tp) noexcept
+        {
+            if (timer_constructed_)
+                timer_.destruct(); // The previous timer operation has completed
+            try
+            {
+                timer_.construct(copy_elider{[&] //
+                    { return exec::connect(exec::schedule_at(schd_, tp), timer_recv(this)); }});
+                timer_constructed_ = true;
+            }
+            catch (...)
+            {
+                timer_constructed_ = false;
+                on_timer(std::current_exception());
+                return;
+            }
+            exec::start(timer_.get());
+        }
+
+        void on_timer(std::exception_ptr ptr) noexcept
+        {
+            ops_base* res = nullptr;
+            std::optional<time_point> arm_at;
+            {
+                std::unique_lock lock(mut_);
+                armed_ = false;
+                if (!ptr)
+                {
+                    try
+                    {
+                        refill();
+                        res = take_satisfied();
+                        arm_at = should_arm();
+                    }
+                    catch (...)
+                    {
+                        ptr = std::current_exception();
+                    }
+                }
+                if (ptr) // Fail every waiting operation, since no timer would wake them up
+                {
+                    res = std::exchange(head_, nullptr);
+                    tail_ = nullptr;
+                }
+            }
+            if (arm_at) // Arm the timer for the rest before resuming anyone
+                arm(*arm_at);
+            while (res)
+            {
+                auto* next = res->next; // In case completing destroys *res
+                if (ptr)
+                    res->set_error(ptr);
+                else
+                    res->set_value();
+                res = next;
+            }
+        }
+    };
+} // namespace clu::async
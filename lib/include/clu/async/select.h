@@ -0,0 +1,208 @@
+#pragma once
+
+#include <tuple>
+#include <variant>
+
+#include "channel.h"
+#include "../meta_algorithm.h"
+
+namespace clu::async
+{
+    namespace detail::slct
+    {
+        template <typename C>
+        struct channel_value
+        {
+        };
+
+        template <typename T, typename P, typename Alloc>
+        struct channel_value<channel<T, P, Alloc>>
+        {
+            using type = T;
+        };
+
+        template <typename C>
+        using channel_value_t = typename channel_value<C>::type;
+
+        template <typename C>
+        concept async_channel = requires { typename channel_value_t<C>; };
+
+        // Waits on one of the channels on behalf of the select operation
+        template <std::size_t I, typename C, typename Ops>
+        class waiter : public chnl::recv_ops_base<channel_value_t<C>, C>
+        {
+        public:
+            using base = chnl::recv_ops_base<channel_value_t<C>, C>;
+
+            waiter(C* chan, Ops* ops) noexcept: base(chan), ops_(ops) {}
+
+            void set_value(channel_value_t<C>&& value) noexcept override
+            {
+                ops_->template set_value<I>(static_cast<channel_value_t<C>&&>(value));
+            }
+
+            void set_error() noexcept override { ops_->set_error(std::current_exception()); }
+            void set_stopped() noexcept override { ops_->set_stopped(); }
+            bool try_claim() noexcept override { return ops_->try_claim(); }
+
+            using base::dequeue;
+            using base::enqueue;
+
+        protected:
+            ~waiter() noexcept = default;
+
+        private:
+            Ops* ops_;
+        };
+
+        template <typename Ops, typename Seq, typename... Cs>
+        struct waiters;
+
+        template <typename Ops, std::size_t... Is, typename... Cs>
+        struct waiters<Ops, std::index_sequence<Is...>, Cs...> final : waiter<Is, Cs, Ops>...
+        {
+            waiters(Ops* ops, Cs*... chnls) noexcept: waiter<Is, Cs, Ops>(chnls, ops)... {}
+        };
+
+        template <typename R, typename... Cs>
+        struct ops_t_
+        {
+            class type;
+        };
+
+        template <typename R, typename... Cs>
+        using ops_t = typename ops_t_<std::decay_t<R>, Cs...>::type;
+
+        template <typename R, typename... Cs>
+        class ops_t_<R, Cs...>::type
+        {
+        public:
+            // clang-format off
+            template <typename R2>
+            explicit type(R2&& recv, Cs*... chnls):
+                recv_(static_cast<R2&&>(recv)), waiters_(this, chnls...) {}
+            // clang-format on
+
+            CLU_IMMOVABLE_TYPE(type);
+
+            bool try_claim() noexcept { return !claimed_.test_and_set(std::memory_order::relaxed); }
+
+            template <std::size_t I, typename T>
+            void set_value(T&& value) noexcept
+            {
+                try
+                {
+                    result_.template emplace<1>(std::in_place_index<I>, static_cast<T&&>(value));
+                }
+                catch (...)
+                {
+                    result_.template emplace<2>(std::current_exception());
+                }
+                arrive();
+            }
+
+            void set_error(std::exception_ptr ptr) noexcept
+            {
+                result_.template emplace<2>(std::move(ptr));
+                arrive();
+            }
+
+            void set_stopped() noexcept
+            {
+                result_.template emplace<3>();
+                arrive();
+            }
+
+        private:
+            using indices = std::index_sequence_for<Cs...>;
+            using value_type = std::variant<channel_value_t<Cs>...>;
+
+            CLU_NO_UNIQUE_ADDRESS R recv_;
+            waiters<type, indices, Cs...> waiters_;
+            std::variant<std::monostate, value_type, std::exception_ptr, exec::set_stopped_t> result_;
+            std::atomic_flag claimed_;
+            // The registration in start and the completion from the channel that yields,
+            // whichever finishes last completes the operation
+            std::atomic_int countdown_ = 2;
+            std::size_t registered_ = 0;
+
+            template <std::size_t I>
+            auto& waiter_at() noexcept
+            {
+                return static_cast<waiter<I, typename meta::nth_type_q<I>::template fn<Cs...>, type>&>(waiters_);
+            }
+
+            void arrive() noexcept
+            {
+                if (countdown_.fetch_sub(1, std::memory_order::acq_rel) == 1)
+                    finish();
+            }
+
+            void finish() noexcept
+            {
+                // Deregister from the other channels, they will not touch the waiters after this
+                [&]<std::size_t... Is>(std::index_sequence<Is...>)
+                {
+                    ((Is < registered_ ? waiter_at<Is>().dequeue() : void()), ...); //
+                }(indices{});
+                switch (result_.index())
+                {
+                    case 1: exec::set_value(static_cast<R&&>(recv_), std::get<1>(std::move(result_))); return;
+                    case 2: exec::set_error(static_cast<R&&>(recv_), std::get<2>(std::move(result_))); return;
+                    case 3: exec::set_stopped(static_cast<R&&>(recv_)); return;
+                    default: unreachable();
+                }
+            }
+
+            friend void tag_invoke(exec::start_t, type& self) noexcept
+            {
+                // Register on the channels in order, until one of them yields
+                [&]<std::size_t... Is>(std::index_sequence<Is...>)
+                {
+                    (void)((self.claimed_.test(std::memory_order::relaxed) ?
+                                   false :
+                                   (self.template waiter_at<Is>().enqueue(), ++self.registered_, true)) &&
+                        ...);
+                }(indices{});
+                self.arrive();
+            }
+        };
+
+        template <typename... Cs>
+        class snd_t
+        {
+        public:
+            using is_sender = void;
+
+            explicit snd_t(Cs*... chnls) noexcept: chnls_(chnls...) {}
+
+            using completion_signatures = exec::completion_signatures< //
+                exec::set_value_t(std::variant<channel_value_t<Cs>...>), //
+                exec::set_error_t(std::exception_ptr), exec::set_stopped_t()>;
+
+        private:
+            std::tuple<Cs*...> chnls_;
+
+            template <typename R>
+            friend auto tag_invoke(exec::connect_t, const snd_t& self, R&& recv)
+            {
+                return std::apply(
+                    [&](Cs*... chnls) { return ops_t<R, Cs...>(static_cast<R&&>(recv), chnls...); }, self.chnls_);
+            }
+        };
+    } // namespace detail::slct
+
+    /**
+     * \brief Receives a value from whichever channel yields first.
+     * \details The operation waits on all the channels with a single registration, and withdraws from the
+     * other channels once one of them yields, so no value gets lost or reordered.
+     * \return A sender which completes with a std::variant, whose active index is the index of the channel
+     * which yielded the value.
+     */
+    template <detail::slct::async_channel... Cs>
+        requires(sizeof...(Cs) > 0)
+    [[nodiscard]] auto select(Cs&... chnls) noexcept
+    {
+        return detail::slct::snd_t<Cs...>(std::addressof(chnls)...);
+    }
+} // namespace clu::async
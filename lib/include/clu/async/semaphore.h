@@ -0,0 +1,115 @@
+#pragma once
+
+#include "../execution/execution_traits.h"
+#include "../concurrency.h"
+
+namespace clu::async
+{
+    class semaphore;
+
+    namespace detail::sema
+    {
+        class ops_base
+        {
+        public:
+            std::size_t count = 0;
+            ops_base* next = nullptr;
+
+            explicit ops_base(const std::size_t n) noexcept: count(n) {}
+            CLU_IMMOVABLE_TYPE(ops_base);
+            virtual void set() noexcept = 0;
+
+        protected:
+            ~ops_base() noexcept = default;
+        };
+
+        template <typename R>
+        struct ops_t_
+        {
+            class type;
+        };
+
+        template <typename R>
+        using ops_t = typename ops_t_<std::decay_t<R>>::type;
+
+        template <typename R>
+        class ops_t_<R>::type final : public ops_base
+        {
+        public:
+            // clang-format off
+            template <typename R2>
+            type(semaphore* sema, const std::size_t n, R2&& recv):
+                ops_base(n), sema_(sema), recv_(static_cast<R2&&>(recv)) {}
+            // clang-format on
+
+            void set() noexcept override { exec::set_value(static_cast<R&&>(recv_)); }
+
+        private:
+            semaphore* sema_;
+            CLU_NO_UNIQUE_ADDRESS R recv_;
+
+            friend void tag_invoke(exec::start_t, type& self) noexcept
+            {
+                if (!start_ops(*self.sema_, self)) // Acquired synchronously
+                    self.set();
+            }
+        };
+
+        class snd_t
+        {
+        public:
+            using is_sender = void;
+
+            explicit snd_t(semaphore* sema, const std::size_t n) noexcept: sema_(sema), n_(n) {}
+
+        private:
+            semaphore* sema_;
+            std::size_t n_;
+
+            // clang-format off
+            friend exec::completion_signatures<exec::set_value_t()> tag_invoke(
+                exec::get_completion_signatures_t, snd_t, auto&&) noexcept { return {}; }
+            // clang-format on
+
+            template <typename R>
+            friend auto tag_invoke(exec::connect_t, const snd_t self, R&& recv)
+            {
+                return ops_t<R>(self.sema_, self.n_, static_cast<R&&>(recv));
+            }
+        };
+    } // namespace detail::sema
+
+    /**
+     * \brief An asynchronous counting semaphore.
+     * \details Waiting operations are resumed in FIFO order, an operation acquiring many units at
+     * once is not starved by later ones acquiring fewer units.
+     */
+    class semaphore
+    {
+    public:
+        explicit semaphore(const std::size_t initial = 0) noexcept: state_(initial << 1) {}
+        CLU_IMMOVABLE_TYPE(semaphore);
+
+        [[nodiscard]] bool try_acquire(std::size_t n = 1) noexcept;
+
+        /// Acquires n units, the resulting sender completes on the context which releases the units.
+        [[nodiscard]] auto acquire_async(const std::size_t n = 1) noexcept { return detail::sema::snd_t(this, n); }
+
+        void release(std::size_t n = 1) noexcept;
+
+    private:
+        using ops_base = detail::sema::ops_base;
+        static constexpr std::size_t waiting_bit = 1;
+
+        // Available count shifted left by one, the lowest bit is set when there are waiting operations.
+        // When the bit is clear, acquiring and releasing are lock-free; when it is set the state
+        // and the waiting queue can only be modified with the spinlock held.
+        std::atomic_size_t state_;
+        spinlock mut_;
+        ops_base* head_ = nullptr;
+        ops_base* tail_ = nullptr;
+
+        friend bool start_ops(semaphore& self, ops_base& ops) noexcept;
+        bool try_acquire_fast(std::size_t n) noexcept;
+    };
+} // namespace clu::async
@@ -94,10 +94,17 @@ namespace clu::async
 
     private:
         using ops_base = detail::shmtx::ops_base;
-        static constexpr std::size_t unique_locked = static_cast<std::size_t>(-1);
 
+        // The lowest bit is set when the mutex is uniquely locked or there are waiting operations,
+        // the state and the queues can only be modified with the spinlock held in this case.
+        // The second bit is set when the mutex is uniquely locked, the other bits are the number
+        // of shared holders. Uncontended shared locking and unlocking are single RMW operations.
+        static constexpr std::size_t slow_bit = 1;
+        static constexpr std::size_t unique_bit = 2;
+        static constexpr std::size_t shared_one = 4;
+
+        std::atomic_size_t state_ = 0;
         spinlock mut_;
-        std::size_t shared_holder_ = 0;
         ops_base* waiting_ = nullptr;
         ops_base* pending_ = nullptr;
 
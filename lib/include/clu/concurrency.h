@@ -1,6 +1,14 @@
 #pragma once
 
+#include "concurrency/concurrent_event.h"
+#include "concurrency/concurrent_hash_map.h"
+#include "concurrency/concurrent_queue.h"
+#include "concurrency/concurrent_stack.h"
 #include "concurrency/hazard_pointer.h"
 #include "concurrency/locked.h"
 #include "concurrency/locked_ptr.h"
+#include "concurrency/mpmc_bounded_queue.h"
+#include "concurrency/rcu_cell.h"
+#include "concurrency/seqlocked.h"
 #include "concurrency/spinlock.h"
+#include "concurrency/spsc_byte_ring.h"
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+
+namespace clu::detail
+{
+    // Alignment which keeps data written by different threads on separate cache lines. Not
+    // std::hardware_destructive_interference_size, since that may vary between compilation flags,
+    // which would change the layout of the types using it.
+    inline constexpr std::size_t cache_line_size = 64;
+} // namespace clu::detail
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include "hazard_pointer.h"
+#include "../assertion.h"
+#include "../concepts.h"
+#include "../function.h"
+#include "../macros.h"
+
+namespace clu
+{
+    /**
+     * \brief An event which can be invoked, subscribed to and unsubscribed from concurrently.
+     * \details Invoking the event only protects the current snapshot of the subscribers with a hazard
+     * pointer and iterates over it, without taking any lock. Subscribing and unsubscribing are serialized
+     * by a mutex. A snapshot is never modified except that new subscribers may be appended past its end,
+     * like a vector, and a full snapshot is copied into a larger one which is then published. Unsubscribing
+     * only marks the subscriber, which is skipped from then on, and the snapshot is compacted once more than
+     * half of it is unsubscribed, so both subscribing and unsubscribing are amortized O(1).
+     * \tparam Ts Parameter types of the event.
+     * \remarks The subscribers may be invoked on multiple threads at the same time, thus they are required
+     * to be const invocable. An invocation which has already started may still call a subscriber after it
+     * is unsubscribed.
+     */
+    template <typename... Ts>
+    class concurrent_event
+    {
+    private:
+        struct node;
+
+    public:
+        /// Handle to a subscriber, which should be unsubscribed at most once.
+        class subscription
+        {
+        private:
+            friend concurrent_event;
+            node* node_ = nullptr;
+            explicit subscription(node* ptr) noexcept: node_(ptr) {}
+        };
+
+        explicit concurrent_event(hazard_pointer_domain& domain = hazard_pointer_default_domain()) noexcept:
+            domain_(&domain)
+        {
+        }
+
+        CLU_IMMOVABLE_TYPE(concurrent_event);
+
+        // Retire instead of deleting, the domain may still hold older snapshots sharing the subscribers
+        ~concurrent_event() noexcept
+        {
+            if (snapshot* snap = snap_.load(std::memory_order::relaxed))
+                snap->retire(*domain_);
+        }
+
+        template <typename F>
+            requires invocable_of<const std::decay_t<F>&, void, Ts...>
+        subscription subscribe(F&& func)
+        {
+            auto fresh = std::make_unique<node>(static_cast<F&&>(func));
+            snapshot* old = nullptr;
+            {
+                std::unique_lock lock(write_mutex_);
+                snapshot* current = snap_.load(std::memory_order::relaxed);
+                if (current && current->size.load(std::memory_order::relaxed) < current->capacity)
+                    current->append(fresh.get());
+                else
+                    old = republish((std::max)(min_capacity, (live_ + 1) * 2), fresh.get());
+                live_++;
+            }
+            if (old)
+                old->retire(*domain_);
+            return subscription(fresh.release()); // Owned by the snapshots now
+        }
+
+        void unsubscribe(const subscription sub) noexcept
+        {
+            snapshot* old = nullptr;
+            {
+                std::unique_lock lock(write_mutex_);
+                CLU_ASSERT(sub.node_->subscribed.load(std::memory_order::relaxed),
+                    "The event subscription is already unsubscribed");
+                sub.node_->subscribed.store(false, std::memory_order::relaxed);
+                live_--;
+                if (++dead_ > live_)
+                {
+                    try
+                    {
+                        old = republish(live_ == 0 ? 0 : (std::max)(min_capacity, live_ * 2), nullptr);
+                    }
+                    catch (const std::bad_alloc&) {} // The unsubscribed ones are skipped anyway, try again later
+                }
+            }
+            if (old)
+                old->retire(*domain_);
+        }
+
+        void operator()(Ts&&... args) const
+        {
+            auto hp = make_hazard_pointer(*domain_);
+            const snapshot* snap = hp.protect(snap_);
+            if (!snap)
+                return;
+            const std::size_t size = snap->size.load(std::memory_order::acquire);
+            for (std::size_t i = 0; i < size; i++)
+                if (const node* sub = snap->nodes[i]; sub->subscribed.load(std::memory_order::relaxed))
+                    sub->func(args...);
+        }
+
+        // clang-format off
+        template <typename F>
+            requires invocable_of<const std::decay_t<F>&, void, Ts...>
+        subscription operator+=(F&& func) { return this->subscribe(static_cast<F&&>(func)); }
+        void operator-=(const subscription sub) noexcept { unsubscribe(sub); }
+        // clang-format on
+
+    private:
+        static constexpr std::size_t min_capacity = 4;
+
+        // Reference counted by the snapshots containing it
+        struct node
+        {
+            move_only_function<void(Ts...) const> func;
+            std::atomic_bool subscribed = true;
+            std::atomic_size_t refs = 0;
+
+            // clang-format off
+            template <typename F>
+            explicit node(F&& f): func(static_cast<F&&>(f)) {}
+            // clang-format on
+
+            void release() noexcept
+            {
+                if (refs.fetch_sub(1, std::memory_order::acq_rel) == 1)
+                    delete this;
+            }
+        };
+
+        struct snapshot : hazard_pointer_obj_base<snapshot>
+        {
+            std::size_t capacity;
+            std::unique_ptr<node*[]> nodes;
+            std::atomic_size_t size = 0; // Only the first size nodes are visible to the readers
+
+            explicit snapshot(const std::size_t cap): capacity(cap), nodes(std::make_unique<node*[]>(cap)) {}
+
+            ~snapshot() noexcept
+            {
+                const std::size_t count = size.load(std::memory_order::relaxed);
+                for (std::size_t i = 0; i < count; i++)
+                    nodes[i]->release();
+            }
+
+            void append(node* sub) noexcept
+            {
+                const std::size_t count = size.load(std::memory_order::relaxed);
+                CLU_ASSERT(count < capacity, "Appending to a full event snapshot");
+                sub->refs.fetch_add(1, std::memory_order::relaxed);
+                nodes[count] = sub;
+                size.store(count + 1, std::memory_order::release);
+            }
+        };
+
+        std::atomic<snapshot*> snap_ = nullptr;
+        hazard_pointer_domain* domain_;
+        std::mutex write_mutex_;
+        std::size_t live_ = 0; // Number of subscribed nodes
+        std::size_t dead_ = 0; // Number of unsubscribed nodes still in the current snapshot
+
+        /*
+         * Publishes a new snapshot with the subscribed nodes of the current one and then extra, or no
+         * snapshot at all if capacity is zero. Returns the previous snapshot, which should be retired
+         * after releasing the lock, since reclaiming it may destroy some subscribers.
+         */
+        snapshot* republish(const std::size_t capacity, node* extra)
+        {
+            snapshot* current = snap_.load(std::memory_order::relaxed);
+            std::unique_ptr<snapshot> fresh;
+            if (capacity != 0)
+            {
+                fresh = std::make_unique<snapshot>(capacity);
+                if (current)
+                {
+                    const std::size_t count = current->size.load(std::memory_order::relaxed);
+                    for (std::size_t i = 0; i < count; i++)
+                        if (node* sub = current->nodes[i]; sub->subscribed.load(std::memory_order::relaxed))
+                            fresh->append(sub);
+                }
+                if (extra)
+                    fresh->append(extra);
+            }
+            snap_.store(fresh.release(), std::memory_order::release);
+            dead_ = 0;
+            return current;
+        }
+    };
+} // namespace clu
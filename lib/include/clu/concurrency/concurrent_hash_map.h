@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "cache_line.h"
+#include "hazard_pointer.h"
+#include "../macros.h"
+
+namespace clu
+{
+    namespace detail::chm
+    {
+        template <typename K, typename V>
+        struct node : hazard_pointer_obj_base<node<K, V>>
+        {
+            std::atomic<node*> next = nullptr;
+            std::atomic_bool removed = false; // Set when unlinked, readers standing on this node should restart
+            std::size_t hash;
+            K key;
+            V value;
+
+            // clang-format off
+            template <typename K2, typename V2>
+            node(const std::size_t h, K2&& k, V2&& v):
+                hash(h), key(static_cast<K2&&>(k)), value(static_cast<V2&&>(v)) {}
+            // clang-format on
+        };
+
+        template <typename K, typename V>
+        struct bucket_array : hazard_pointer_obj_base<bucket_array<K, V>>
+        {
+            std::size_t mask;
+            std::unique_ptr<std::atomic<node<K, V>*>[]> heads;
+            std::atomic_bool stale = false; // Set when replaced, readers in this array should restart
+
+            explicit bucket_array(const std::size_t count):
+                mask(count - 1), heads(std::make_unique<std::atomic<node<K, V>*>[]>(count))
+            {
+            }
+
+            std::size_t count() const noexcept { return mask + 1; }
+        };
+
+        template <typename K, typename V>
+        struct alignas(cache_line_size) segment
+        {
+            std::mutex mutex; // Writers of this segment serialize on this mutex, readers never take it
+            std::atomic<bucket_array<K, V>*> buckets;
+            std::atomic_size_t size = 0;
+        };
+    } // namespace detail::chm
+
+    /**
+     * \brief A concurrent hash map with lock-free lookups.
+     * \details The map is split into segments. Writers lock only the segment the key belongs to, while
+     * readers never lock and never write to shared memory other than their own hazard pointers. Nodes are
+     * immutable once published, an assignment replaces the node. When a segment gets too crowded, only
+     * that segment is rehashed into a new bucket array, readers keep going on the old one meanwhile. Unlinked
+     * nodes and replaced bucket arrays are reclaimed through the hazard pointer domain.
+     * \tparam K Key type.
+     * \tparam V Mapped type.
+     * \remarks Since readers may still be reading the old nodes, rehashing copies the elements instead of
+     * moving them, so both K and V need to be copy constructible.
+     */
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+        requires std::copy_constructible<K> && std::copy_constructible<V>
+    class concurrent_hash_map
+    {
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        static constexpr std::size_t segment_count = 16;
+
+        /**
+         * \brief Constructs an empty map.
+         * \param bucket_count Initial number of buckets across all the segments.
+         * \param domain The hazard pointer domain to protect the lookups and reclaim the nodes with.
+         */
+        explicit concurrent_hash_map(const std::size_t bucket_count = segment_count * 4,
+            hazard_pointer_domain& domain = hazard_pointer_default_domain()):
+            domain_(&domain)
+        {
+            const std::size_t per_segment = std::bit_ceil(std::max<std::size_t>(bucket_count / segment_count, 1));
+            std::size_t i = 0;
+            try
+            {
+                for (; i < segment_count; i++)
+                    segments_[i].buckets.store(new bucket_array(per_segment), std::memory_order::relaxed);
+            }
+            catch (...)
+            {
+                for (std::size_t j = 0; j < i; j++)
+                    delete segments_[j].buckets.load(std::memory_order::relaxed);
+                throw;
+            }
+        }
+
+        CLU_IMMOVABLE_TYPE(concurrent_hash_map);
+
+        ~concurrent_hash_map() noexcept
+        {
+            for (auto& seg : segments_)
+            {
+                auto* bkts = seg.buckets.load(std::memory_order::relaxed);
+                for_each_node(*bkts, [](node* n) { delete n; });
+                delete bkts;
+            }
+        }
+
+        /// Returns a copy of the value mapped to key, or an empty optional if there is no such key.
+        [[nodiscard]] std::optional<V> find(const K& key) const
+        {
+            std::optional<V> result;
+            visit(key, [&](const V& value) { result.emplace(value); });
+            return result;
+        }
+
+        [[nodiscard]] bool contains(const K& key) const
+        {
+            return visit(key, [](const V&) {});
+        }
+
+        /**
+         * \brief Invokes a function with the value mapped to key, if there is one.
+         * \details The value is protected from being reclaimed during the invocation. It could be replaced
+         * or erased concurrently, in which case the function sees the value before the modification.
+         * \return Whether the key is found.
+         */
+        template <std::invocable<const V&> F>
+        bool visit(const K& key, F&& func) const
+        {
+            const std::size_t hash = hasher_(key);
+            const segment& seg = segment_of(hash);
+            // One for the bucket array, two for walking the chain hand over hand
+            auto hps = make_hazard_pointer_array<3>(*domain_);
+            while (true)
+            {
+                const bucket_array* bkts = hps[0].protect(seg.buckets);
+                const auto& head = bkts->heads[bucket_index(hash, *bkts)];
+                node* cur = hps[1].protect(head);
+                if (bkts->stale.load(std::memory_order::acquire)) // Rehashed, cur may be retired already
+                    continue;
+                if (find_in_chain(hps, cur, hash, key))
+                {
+                    std::invoke(static_cast<F&&>(func), std::as_const(cur->value));
+                    return true;
+                }
+                if (!cur) // Reached the end of the chain
+                    return false;
+                // Otherwise the chain was modified under our feet, try again
+            }
+        }
+
+        /// Inserts a key-value pair if the key doesn't exist yet, returns whether the insertion took place.
+        template <typename K2 = K, typename V2 = V>
+        bool insert(K2&& key, V2&& value)
+        {
+            return insert_impl(static_cast<K2&&>(key), static_cast<V2&&>(value), false);
+        }
+
+        /// Inserts a key-value pair or replaces the existing value, returns whether an insertion took place.
+        template <typename K2 = K, typename V2 = V>
+        bool insert_or_assign(K2&& key, V2&& value)
+        {
+            return insert_impl(static_cast<K2&&>(key), static_cast<V2&&>(value), true);
+        }
+
+        /// Removes the key, returns whether the key existed.
+        bool erase(const K& key)
+        {
+            const std::size_t hash = hasher_(key);
+            segment& seg = segment_of(hash);
+            node* victim = nullptr;
+            {
+                std::unique_lock lock(seg.mutex);
+                auto* bkts = seg.buckets.load(std::memory_order::relaxed);
+                std::atomic<node*>* link = &bkts->heads[bucket_index(hash, *bkts)];
+                for (node* cur = link->load(std::memory_order::relaxed); cur;
+                     link = &cur->next, cur = link->load(std::memory_order::relaxed))
+                {
+                    if (cur->hash != hash || !equal_(cur->key, key))
+                        continue;
+                    link->store(cur->next.load(std::memory_order::relaxed), std::memory_order::release);
+                    cur->removed.store(true, std::memory_order::release);
+                    seg.size.store(seg.size.load(std::memory_order::relaxed) - 1, std::memory_order::relaxed);
+                    victim = cur;
+                    break;
+                }
+            }
+            if (!victim)
+                return false;
+            victim->retire(*domain_);
+            return true;
+        }
+
+        /// Removes every element, the concurrent readers still see the elements they are visiting.
+        void clear()
+        {
+            for (auto& seg : segments_)
+            {
+                bucket_array* old;
+                {
+                    std::unique_lock lock(seg.mutex);
+                    old = seg.buckets.load(std::memory_order::relaxed);
+                    seg.buckets.store(new bucket_array(old->count()), std::memory_order::release);
+                    seg.size.store(0, std::memory_order::relaxed);
+                    mark_stale(*old);
+                }
+                retire_array(old);
+            }
+        }
+
+        /// Number of elements, only a snapshot when there are concurrent writers.
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            std::size_t sum = 0;
+            for (const auto& seg : segments_)
+                sum += seg.size.load(std::memory_order::relaxed);
+            return sum;
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    private:
+        using node = detail::chm::node<K, V>;
+        using bucket_array = detail::chm::bucket_array<K, V>;
+        using segment = detail::chm::segment<K, V>;
+
+        static constexpr std::size_t segment_bits = std::countr_zero(segment_count);
+        static constexpr std::size_t max_load_factor = 2;
+
+        hazard_pointer_domain* domain_;
+        CLU_NO_UNIQUE_ADDRESS Hash hasher_;
+        CLU_NO_UNIQUE_ADDRESS KeyEqual equal_;
+        segment segments_[segment_count];
+
+        segment& segment_of(const std::size_t hash) noexcept { return segments_[hash & (segment_count - 1)]; }
+        const segment& segment_of(const std::size_t hash) const noexcept
+        {
+            return segments_[hash & (segment_count - 1)];
+        }
+
+        static std::size_t bucket_index(const std::size_t hash, const bucket_array& bkts) noexcept
+        {
+            return (hash >> segment_bits) & bkts.mask;
+        }
+
+        // Walks the chain starting at cur, which is protected by hps[1]. Returns true if the key is found,
+        // with cur being the protected node. Otherwise cur is null if the end is reached, or non-null if
+        // the node we were standing on got unlinked.
+        bool find_in_chain(hazard_pointer_array<3>& hps, node*& cur, const std::size_t hash, const K& key) const
+        {
+            std::size_t slot = 1;
+            while (cur)
+            {
+                if (cur->hash == hash && equal_(cur->key, key))
+                    return true;
+                const std::size_t next_slot = 3 - slot;
+                node* next = hps[next_slot].protect(cur->next);
+                // If cur is still linked after protecting next, next is not retired yet,
+                // since a node is always marked before anything after it gets retired
+                if (cur->removed.load(std::memory_order::acquire))
+                    return false;
+                cur = next;
+                slot = next_slot;
+            }
+            return false;
+        }
+
+        template <typename K2, typename V2>
+        bool insert_impl(K2&& key, V2&& value, const bool assign)
+        {
+            // Construct the node outside the lock
+            auto new_node = std::make_unique<node>(0, static_cast<K2&&>(key), static_cast<V2&&>(value));
+            const std::size_t hash = new_node->hash = hasher_(std::as_const(new_node->key));
+            segment& seg = segment_of(hash);
+            bucket_array* retired_array = nullptr;
+            node* replaced = nullptr;
+            {
+                std::unique_lock lock(seg.mutex);
+                auto* bkts = seg.buckets.load(std::memory_order::relaxed);
+                std::atomic<node*>* link = &bkts->heads[bucket_index(hash, *bkts)];
+                for (node* cur = link->load(std::memory_order::relaxed); cur;
+                     link = &cur->next, cur = link->load(std::memory_order::relaxed))
+                {
+                    if (cur->hash != hash || !equal_(cur->key, new_node->key))
+                        continue;
+                    if (!assign)
+                        return false;
+                    new_node->next.store(cur->next.load(std::memory_order::relaxed), std::memory_order::relaxed);
+                    link->store(new_node.release(), std::memory_order::release);
+                    cur->removed.store(true, std::memory_order::release);
+                    replaced = cur;
+                    break;
+                }
+                if (!replaced)
+                {
+                    // Grow before inserting, so that a throwing rehash leaves the map untouched
+                    const std::size_t size = seg.size.load(std::memory_order::relaxed) + 1;
+                    if (size > bkts->count() * max_load_factor)
+                    {
+                        retired_array = bkts;
+                        bkts = rehash(seg, *bkts);
+                    }
+                    auto& head = bkts->heads[bucket_index(hash, *bkts)];
+                    new_node->next.store(head.load(std::memory_order::relaxed), std::memory_order::relaxed);
+                    head.store(new_node.release(), std::memory_order::release);
+                    seg.size.store(size, std::memory_order::relaxed);
+                }
+            }
+            if (replaced)
+                replaced->retire(*domain_);
+            if (retired_array)
+                retire_array(retired_array);
+            return !replaced;
+        }
+
+        // Copies the elements into a bucket array twice as large and publishes it, needs to be called
+        // with the lock of the segment held. The old array is marked stale but not retired.
+        bucket_array* rehash(segment& seg, bucket_array& old)
+        {
+            auto fresh = std::make_unique<bucket_array>(old.count() * 2);
+            try
+            {
+                for_each_node(old,
+                    [&](const node* n)
+                    {
+                        auto& head = fresh->heads[bucket_index(n->hash, *fresh)];
+                        auto* copy = new node(n->hash, n->key, n->value);
+                        copy->next.store(head.load(std::memory_order::relaxed), std::memory_order::relaxed);
+                        head.store(copy, std::memory_order::relaxed);
+                    });
+            }
+            catch (...)
+            {
+                for_each_node(*fresh, [](node* n) { delete n; });
+                throw;
+            }
+            seg.buckets.store(fresh.get(), std::memory_order::release);
+            mark_stale(old);
+            return fresh.release();
+        }
+
+        // Readers in the old array restart once they see these marks
+        static void mark_stale(bucket_array& bkts) noexcept
+        {
+            bkts.stale.store(true, std::memory_order::release);
+            for_each_node(bkts, [](node* n) { n->removed.store(true, std::memory_order::release); });
+        }
+
+        void retire_array(bucket_array* bkts) noexcept
+        {
+            for_each_node(*bkts, [this](node* n) { n->retire(*domain_); });
+            bkts->retire(*domain_);
+        }
+
+        // The function may destroy the node
+        template <typename F>
+        static void for_each_node(const bucket_array& bkts, F&& func)
+        {
+            for (std::size_t i = 0; i < bkts.count(); i++)
+            {
+                node* cur = bkts.heads[i].load(std::memory_order::relaxed);
+                while (cur)
+                {
+                    node* next = cur->next.load(std::memory_order::relaxed);
+                    func(cur);
+                    cur = next;
+                }
+            }
+        }
+    };
+} // namespace clu
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <optional>
+
+#include "hp_node_pool.h"
+#include "../scope.h"
+
+namespace clu
+{
+    /**
+     * \brief A lock-free unbounded multi-producer multi-consumer FIFO queue (Michael-Scott queue).
+     * \details Dequeued nodes are protected by hazard pointers and reclaimed through the hazard pointer
+     * domain, which also prevents the ABA problem. Reclaimed nodes go into a free list for later pushes,
+     * so a queue in a steady state doesn't allocate.
+     * \tparam T Type of the elements, needs to be nothrow move constructible since the value is moved
+     * out after the node is unlinked, where there is no going back.
+     */
+    template <typename T>
+        requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+    class concurrent_queue
+    {
+    public:
+        using value_type = T;
+
+        explicit concurrent_queue(hazard_pointer_domain& domain = hazard_pointer_default_domain()):
+            pool_(new pool(domain))
+        {
+            node* dummy = nullptr;
+            try
+            {
+                dummy = new node;
+            }
+            catch (...)
+            {
+                pool_->release();
+                throw;
+            }
+            head_.store(dummy, std::memory_order::relaxed);
+            tail_.store(dummy, std::memory_order::relaxed);
+        }
+
+        CLU_IMMOVABLE_TYPE(concurrent_queue);
+
+        ~concurrent_queue() noexcept
+        {
+            node* current = head_.load(std::memory_order::relaxed);
+            node* next = current->next.load(std::memory_order::relaxed);
+            delete current; // The dummy node holds no value
+            while (next)
+            {
+                current = next;
+                next = current->next.load(std::memory_order::relaxed);
+                current->value.destruct();
+                delete current;
+            }
+            pool_->release();
+        }
+
+        void push(const T& value) { this->emplace(value); }
+        void push(T&& value) { this->emplace(static_cast<T&&>(value)); }
+
+        template <typename... Args>
+            requires std::constructible_from<T, Args...>
+        void emplace(Args&&... args)
+        {
+            auto hp = make_hazard_pointer(pool_->domain());
+            node* fresh = pool_->acquire(hp);
+            {
+                // Others may still be looking at the node through a stale free list head, so it must be retired
+                scope_fail guard([&]() noexcept { pool_->retire(fresh); });
+                fresh->value.construct(static_cast<Args&&>(args)...);
+            }
+            fresh->next.store(nullptr, std::memory_order::relaxed);
+            while (true)
+            {
+                node* tail = hp.protect(tail_);
+                node* next = tail->next.load(std::memory_order::acquire);
+                if (next) // The tail is lagging behind, help moving it forward
+                {
+                    (void)tail_.compare_exchange_strong(tail, next, //
+                        std::memory_order::release, std::memory_order::relaxed);
+                    continue;
+                }
+                if (tail->next.compare_exchange_weak(next, fresh, //
+                        std::memory_order::release, std::memory_order::relaxed))
+                {
+                    (void)tail_.compare_exchange_strong(tail, fresh, //
+                        std::memory_order::release, std::memory_order::relaxed);
+                    return;
+                }
+            }
+        }
+
+        /// Pops the front element, returns an empty optional if the queue is empty.
+        [[nodiscard]] std::optional<T> try_pop()
+        {
+            auto hps = make_hazard_pointer_array<2>(pool_->domain());
+            while (true)
+            {
+                node* head = hps[0].protect(head_);
+                node* next = head->next.load(std::memory_order::acquire);
+                if (!hps[1].try_protect(next, head->next))
+                    continue;
+                // next is retired only after head_ moves past it, so next is safe if head_ is still head
+                if (head_.load(std::memory_order::acquire) != head)
+                    continue;
+                if (!next)
+                    return std::nullopt;
+                node* tail = tail_.load(std::memory_order::acquire);
+                if (head == tail) // Never let head_ overtake tail_, so tail_ never points to a retired node
+                {
+                    (void)tail_.compare_exchange_strong(tail, next, //
+                        std::memory_order::release, std::memory_order::relaxed);
+                    continue;
+                }
+                if (head_.compare_exchange_strong(head, next, //
+                        std::memory_order::acquire, std::memory_order::relaxed))
+                {
+                    // next becomes the new dummy node, only we may touch its value now
+                    std::optional<T> result(std::in_place, std::move(next->value).get());
+                    next->value.destruct();
+                    hps[0].reset_protection();
+                    pool_->retire(head);
+                    return result;
+                }
+            }
+        }
+
+        /// Checks if the queue is empty, the result may be stale by the time it is used.
+        [[nodiscard]] bool empty() const
+        {
+            auto hp = make_hazard_pointer(pool_->domain());
+            const node* head = hp.protect(head_);
+            return head->next.load(std::memory_order::acquire) == nullptr;
+        }
+
+    private:
+        using node = detail::hp_value_node<T>;
+        using pool = detail::hp_node_pool<node>;
+
+        alignas(detail::cache_line_size) std::atomic<node*> head_ = nullptr;
+        alignas(detail::cache_line_size) std::atomic<node*> tail_ = nullptr;
+        pool* pool_;
+    };
+} // namespace clu
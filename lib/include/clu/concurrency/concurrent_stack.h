@@ -0,0 +1,96 @@
+#pragma once
+
+#include <optional>
+
+#include "hp_node_pool.h"
+#include "../scope.h"
+
+namespace clu
+{
+    /**
+     * \brief A lock-free unbounded stack (Treiber stack).
+     * \details Popped nodes are protected by hazard pointers and reclaimed through the hazard pointer
+     * domain, which also prevents the ABA problem. Reclaimed nodes go into a free list for later pushes,
+     * so a stack in a steady state doesn't allocate.
+     * \tparam T Type of the elements, needs to be nothrow move constructible since the value is moved
+     * out after the node is unlinked, where there is no going back.
+     */
+    template <typename T>
+        requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+    class concurrent_stack
+    {
+    public:
+        using value_type = T;
+
+        explicit concurrent_stack(hazard_pointer_domain& domain = hazard_pointer_default_domain()):
+            pool_(new pool(domain))
+        {
+        }
+
+        CLU_IMMOVABLE_TYPE(concurrent_stack);
+
+        ~concurrent_stack() noexcept
+        {
+            node* current = head_.load(std::memory_order::relaxed);
+            while (current)
+            {
+                current->value.destruct();
+                delete std::exchange(current, current->next.load(std::memory_order::relaxed));
+            }
+            pool_->release();
+        }
+
+        void push(const T& value) { this->emplace(value); }
+        void push(T&& value) { this->emplace(static_cast<T&&>(value)); }
+
+        template <typename... Args>
+            requires std::constructible_from<T, Args...>
+        void emplace(Args&&... args)
+        {
+            auto hp = make_hazard_pointer(pool_->domain());
+            node* fresh = pool_->acquire(hp);
+            {
+                // Others may still be looking at the node through a stale free list head, so it must be retired
+                scope_fail guard([&]() noexcept { pool_->retire(fresh); });
+                fresh->value.construct(static_cast<Args&&>(args)...);
+            }
+            node* head = head_.load(std::memory_order::relaxed);
+            do fresh->next.store(head, std::memory_order::relaxed);
+            while (!head_.compare_exchange_weak(head, fresh, //
+                std::memory_order::release, std::memory_order::relaxed));
+        }
+
+        /// Pops the top element, returns an empty optional if the stack is empty.
+        [[nodiscard]] std::optional<T> try_pop()
+        {
+            auto hp = make_hazard_pointer(pool_->domain());
+            while (true)
+            {
+                node* head = hp.protect(head_);
+                if (!head)
+                    return std::nullopt;
+                // head is protected, so it can't be recycled and pushed again in the meantime
+                node* next = head->next.load(std::memory_order::relaxed);
+                if (head_.compare_exchange_weak(head, next, //
+                        std::memory_order::acquire, std::memory_order::relaxed))
+                {
+                    std::optional<T> result(std::in_place, std::move(head->value).get());
+                    head->value.destruct();
+                    hp.reset_protection();
+                    pool_->retire(head);
+                    return result;
+                }
+            }
+        }
+
+        /// Checks if the stack is empty, the result may be stale by the time it is used.
+        [[nodiscard]] bool empty() const noexcept { return head_.load(std::memory_order::acquire) == nullptr; }
+
+    private:
+        using node = detail::hp_value_node<T>;
+        using pool = detail::hp_node_pool<node>;
+
+        std::atomic<node*> head_ = nullptr;
+        pool* pool_;
+    };
+} // namespace clu
@@ -7,15 +7,24 @@
 #include <memory>
 #include <memory_resource>
 #include <atomic>
+#include <concepts>
 #include <span>
 #include <utility>
 
 #include "../macros.h"
 #include "locked_ptr.h"
+#include "spinlock.h"
 
 namespace clu
 {
+    namespace exec
+    {
+        class any_scheduler;
+    }
+
     class hazard_pointer;
+    template <std::size_t N>
+    class hazard_pointer_array;
     class hazard_pointer_domain;
     template <typename T, typename D>
     class hazard_pointer_obj_base;
@@ -32,19 +41,76 @@ namespace clu
             hp_obj_node* next_ = nullptr;
             void (*dtor_)(hp_obj_node& self) noexcept = nullptr;
         };
+
+        // Asymmetric fences: the readers (protecting) only need a compiler barrier, as long as the
+        // reclaimer issues a process-wide memory barrier which serializes all the running threads.
+#if defined(_WIN32)
+        constexpr bool hp_asymmetric_fence_available() noexcept { return true; }
+#elif defined(__linux__)
+        // Set when the process is registered for expedited membarrier(2) calls
+        inline std::atomic_bool hp_membarrier_registered = false;
+        inline bool hp_asymmetric_fence_available() noexcept
+        {
+            return hp_membarrier_registered.load(std::memory_order::relaxed);
+        }
+#else
+        constexpr bool hp_asymmetric_fence_available() noexcept { return false; }
+#endif
+
+        inline void hp_light_fence() noexcept
+        {
+            if (hp_asymmetric_fence_available()) [[likely]]
+                std::atomic_signal_fence(std::memory_order::seq_cst);
+            else
+            {
+                CLU_GCC_WNO_TSAN
+                std::atomic_thread_fence(std::memory_order::seq_cst);
+                CLU_GCC_RESTORE_WARNING
+            }
+        }
+
+        void hp_heavy_fence() noexcept;
     } // namespace detail
 
+    struct hazard_pointer_domain_stats
+    {
+        std::size_t backlog = 0; ///< Number of retired objects which are not reclaimed yet.
+        std::size_t reclaimed = 0; ///< Total number of reclaimed objects.
+        std::size_t async_runs = 0; ///< Number of reclamation runs executed on the reclamation scheduler.
+    };
+
     class hazard_pointer_domain
     {
     public:
         using allocator = std::pmr::polymorphic_allocator<>;
 
+        static constexpr std::size_t default_reclamation_batch = 1000;
+
         CLU_IMMOVABLE_TYPE(hazard_pointer_domain);
         hazard_pointer_domain() noexcept: hazard_pointer_domain(allocator{}) {}
         explicit hazard_pointer_domain(allocator alloc) noexcept;
         ~hazard_pointer_domain() noexcept;
         void clean_up() noexcept { reclaim(0); }
 
+        /**
+         * \brief Moves the reclamation triggered by retiring objects off the retiring threads.
+         * \details Once set, retiring an object never runs the deleters inline. The reclamation is posted
+         * onto the scheduler instead, and each run reclaims at most batch_size objects before posting
+         * the rest as another run, so that other work on the execution context is not held up. If the
+         * scheduling fails, the reclamation falls back to the thread which requested it.
+         * \param schd The scheduler to post the reclamation runs onto, its execution context must keep
+         * running until the scheduler is cleared or the domain is destroyed.
+         * \param batch_size Maximum number of objects to reclaim in a single run.
+         * \remarks Include clu/execution/any_scheduler.h to convert a concrete scheduler.
+         */
+        void set_reclamation_scheduler(const exec::any_scheduler& schd,
+            std::size_t batch_size = default_reclamation_batch);
+
+        /// Goes back to reclaiming on the retiring threads, waits for the in-flight run to finish.
+        void clear_reclamation_scheduler() noexcept;
+
+        [[nodiscard]] hazard_pointer_domain_stats stats() const noexcept;
+
     private:
         friend detail::hp_impl;
         friend detail::hp_cache;
@@ -69,16 +135,36 @@ namespace clu
         std::atomic_size_t hp_count_;
         std::atomic<detail::hp_obj_node*> retired_[n_shards];
 
+        // Statistics
+        std::atomic_size_t backlog_;
+        std::atomic_size_t reclaimed_;
+        std::atomic_size_t async_runs_;
+
+        // Asynchronous reclamation, reclaim_requests_ is non-zero while a run is posted or running
+        spinlock schd_lock_;
+        std::unique_ptr<exec::any_scheduler> schd_;
+        std::size_t batch_size_ = default_reclamation_batch;
+        std::atomic_bool async_reclaim_;
+        std::atomic_size_t reclaim_requests_;
+        std::atomic_int64_t requested_count_; // Taken off retired_count_ by the requests, handed to the runs
+
         detail::hp_impl* allocate_hp();
         detail::hp_impl* acquire_hp();
         detail::hp_impl* try_acquire_available_hp() noexcept;
+        detail::hp_impl* try_acquire_available_hps(std::size_t count) noexcept;
         void return_available_hp(detail::hp_impl* hp) noexcept;
+        void return_available_hps(detail::hp_impl* first, detail::hp_impl* last) noexcept;
         void retire_object(detail::hp_obj_node* node) noexcept;
         void check_reclaim() noexcept;
         std::int64_t check_retired_count() noexcept;
         std::int64_t check_due() noexcept;
         void reclaim(std::int64_t count) noexcept;
-        std::int64_t reclaim_all_non_matching(std::span<detail::hp_obj_node* const> lists, bool& done) noexcept;
+        std::int64_t reclaim_all_non_matching(
+            std::span<detail::hp_obj_node* const> lists, bool& done, std::size_t budget) noexcept;
+        void request_async_reclaim(std::int64_t count) noexcept;
+        void post_async_reclaim() noexcept;
+        void run_async_reclaim() noexcept;
+        void fallback_reclaim() noexcept;
         bool no_retired() const noexcept;
 
         friend hazard_pointer make_hazard_pointer(hazard_pointer_domain& domain);
@@ -107,7 +193,7 @@ namespace clu
             domain.retire_object(this);
         }
 
-        void retire(hazard_pointer_domain& domain = hazard_pointer_default_domain()) noexcept
+        void retire(hazard_pointer_domain& domain) noexcept
         {
             this->retire(D(), domain);
         }
@@ -142,7 +228,7 @@ namespace clu
         {
             T* p = ptr;
             this->reset_protection(p);
-            std::atomic_thread_fence(std::memory_order::seq_cst);
+            detail::hp_light_fence(); // Pairs with the heavy fence in the reclamation
             ptr = src.load(std::memory_order::acquire);
             if (p == ptr) [[likely]] // No one modified the atomic pointer while we're trying to protect it
                 return true;
@@ -164,12 +250,65 @@ namespace clu
         friend hazard_pointer make_hazard_pointer(hazard_pointer_domain& domain);
 
     private:
+        template <std::size_t N>
+        friend class hazard_pointer_array;
+
         detail::hp_impl* hptr_ = nullptr;
 
         explicit hazard_pointer(detail::hp_impl* hptr) noexcept: hptr_(hptr) {}
         void destruct() const noexcept;
+        static void acquire_n(hazard_pointer_domain& domain, std::span<hazard_pointer> hps);
+        static void release_n(std::span<hazard_pointer> hps) noexcept;
         void reset_hazard(const detail::hp_obj_node* ptr) noexcept;
     };
 
     hazard_pointer make_hazard_pointer(hazard_pointer_domain& domain = hazard_pointer_default_domain());
+
+    /**
+     * \brief A fixed number of hazard pointers which are acquired and released together.
+     * \details Traversing linked structures usually needs several hazard pointers at once, acquiring
+     * them in a batch only touches the thread local cache or the domain's available list once.
+     */
+    template <std::size_t N>
+    class hazard_pointer_array
+    {
+    public:
+        hazard_pointer_array() noexcept = default;
+        hazard_pointer_array(hazard_pointer_array&& other) noexcept { swap(other); }
+        hazard_pointer_array& operator=(hazard_pointer_array&& other) noexcept
+        {
+            if (&other != this)
+            {
+                hazard_pointer::release_n(hps_);
+                swap(other);
+            }
+            return *this;
+        }
+        ~hazard_pointer_array() noexcept { hazard_pointer::release_n(hps_); }
+
+        [[nodiscard]] static constexpr std::size_t size() noexcept { return N; }
+        [[nodiscard]] bool empty() const noexcept { return hps_[0].empty(); }
+
+        [[nodiscard]] hazard_pointer& operator[](const std::size_t index) noexcept { return hps_[index]; }
+        [[nodiscard]] const hazard_pointer& operator[](const std::size_t index) const noexcept { return hps_[index]; }
+
+        void swap(hazard_pointer_array& other) noexcept { std::ranges::swap(hps_, other.hps_); }
+        friend void swap(hazard_pointer_array& lhs, hazard_pointer_array& rhs) noexcept { lhs.swap(rhs); }
+
+        template <std::size_t M>
+        friend hazard_pointer_array<M> make_hazard_pointer_array(hazard_pointer_domain& domain);
+
+    private:
+        hazard_pointer hps_[N];
+
+        // If the acquisition throws, the hazard pointers acquired so far are released one by one
+        explicit hazard_pointer_array(hazard_pointer_domain& domain) { hazard_pointer::acquire_n(domain, hps_); }
+    };
+
+    template <std::size_t N>
+    hazard_pointer_array<N> make_hazard_pointer_array(hazard_pointer_domain& domain = hazard_pointer_default_domain())
+    {
+        static_assert(N > 0, "A hazard pointer array should hold at least one hazard pointer");
+        return hazard_pointer_array<N>(domain);
+    }
 } // namespace clu
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "cache_line.h"
+#include "hazard_pointer.h"
+#include "../macros.h"
+#include "../manual_lifetime.h"
+
+namespace clu::detail
+{
+    template <typename Node>
+    class hp_node_pool;
+
+    // Returns the retired nodes to the pool instead of deleting them
+    template <typename Node>
+    struct hp_node_recycler
+    {
+        hp_node_pool<Node>* pool = nullptr;
+        void operator()(Node* node) const noexcept { pool->recycle(node); }
+    };
+
+    // Node type of the linked lock-free containers, the value is alive only while the node is in the container
+    template <typename T>
+    struct hp_value_node : hazard_pointer_obj_base<hp_value_node<T>, hp_node_recycler<hp_value_node<T>>>
+    {
+        std::atomic<hp_value_node*> next = nullptr;
+        manual_lifetime<T> value;
+    };
+
+    /*
+     * A lock-free free list of nodes. Popping from the list protects the head with a hazard pointer,
+     * and the nodes only come back to the list after they are reclaimed by the hazard pointer domain,
+     * so a node can't be popped and pushed back while someone is looking at it, thus no ABA problem.
+     * The pool is reference counted by its owner and the retired nodes which are not recycled yet,
+     * so that the pool outlives the owner if the domain reclaims the nodes later.
+     */
+    template <typename Node>
+    class hp_node_pool
+    {
+    public:
+        explicit hp_node_pool(hazard_pointer_domain& domain) noexcept: domain_(&domain) {}
+        CLU_IMMOVABLE_TYPE(hp_node_pool);
+
+        [[nodiscard]] hazard_pointer_domain& domain() const noexcept { return *domain_; }
+
+        // hp should be empty, it is used for protecting the free list and reset afterwards
+        Node* acquire(hazard_pointer& hp)
+        {
+            Node* head = free_.load(std::memory_order::relaxed);
+            while (head)
+            {
+                if (!hp.try_protect(head, free_))
+                    continue;
+                Node* next = head->next.load(std::memory_order::relaxed);
+                if (free_.compare_exchange_weak(head, next, //
+                        std::memory_order::acquire, std::memory_order::relaxed))
+                {
+                    hp.reset_protection();
+                    return head;
+                }
+            }
+            hp.reset_protection();
+            return new Node;
+        }
+
+        void retire(Node* node) noexcept
+        {
+            refs_.fetch_add(1, std::memory_order::relaxed);
+            node->retire(hp_node_recycler<Node>{this}, *domain_);
+        }
+
+        void recycle(Node* node) noexcept
+        {
+            give_back(node);
+            release();
+        }
+
+        void release() noexcept
+        {
+            if (refs_.fetch_sub(1, std::memory_order::acq_rel) == 1)
+                delete this;
+        }
+
+    private:
+        alignas(cache_line_size) std::atomic<Node*> free_ = nullptr;
+        alignas(cache_line_size) std::atomic_size_t refs_ = 1;
+        hazard_pointer_domain* domain_;
+
+        ~hp_node_pool() noexcept
+        {
+            Node* node = free_.load(std::memory_order::relaxed);
+            while (node)
+                delete std::exchange(node, node->next.load(std::memory_order::relaxed));
+        }
+
+        /*
+         * Only for nodes coming back from the domain. A node which has just been acquired may still be
+         * looked at by another thread which read it as the head of the free list, that thread would then
+         * succeed in its CAS with a stale next pointer, so such nodes should be retired instead.
+         */
+        void give_back(Node* node) noexcept
+        {
+            Node* head = free_.load(std::memory_order::relaxed);
+            do node->next.store(head, std::memory_order::relaxed);
+            while (!free_.compare_exchange_weak(head, node, //
+                std::memory_order::release, std::memory_order::relaxed));
+        }
+    };
+} // namespace clu::detail
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <utility>
+
+#include "cache_line.h"
+#include "../assertion.h"
+#include "../macros.h"
+#include "../manual_lifetime.h"
+
+namespace clu
+{
+    /**
+     * \brief A lock-free bounded multi-producer multi-consumer FIFO queue (Vyukov's array queue).
+     * \details Each slot carries a sequence number telling which lap of the ring it's ready for, so
+     * producers and consumers only contend on the slots and on their own position counters. The slots
+     * are padded to a cache line each, so that neighbouring operations don't false share. All the
+     * storage is allocated upfront, the queue never allocates afterwards.
+     * \tparam T Type of the elements, needs to be nothrow move constructible since the values are
+     * constructed into slots which are already claimed.
+     */
+    template <typename T>
+        requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+    class mpmc_bounded_queue
+    {
+    public:
+        using value_type = T;
+
+        /// Constructs an empty queue, the capacity is rounded up to a power of two.
+        explicit mpmc_bounded_queue(const std::size_t capacity):
+            mask_(std::bit_ceil(capacity) - 1), slots_(std::make_unique<slot[]>(mask_ + 1))
+        {
+            CLU_ASSERT(capacity != 0, "the capacity of an mpmc_bounded_queue must not be zero");
+            for (std::size_t i = 0; i <= mask_; i++)
+                slots_[i].sequence.store(i, std::memory_order::relaxed);
+        }
+
+        CLU_IMMOVABLE_TYPE(mpmc_bounded_queue);
+
+        ~mpmc_bounded_queue() noexcept
+        {
+            while (try_pop()) {}
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+        bool try_push(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        {
+            return this->try_emplace(value);
+        }
+
+        bool try_push(T&& value) noexcept { return this->try_emplace(static_cast<T&&>(value)); }
+
+        /**
+         * \brief Constructs an element at the back of the queue if it is not full.
+         * \details If the constructor may throw, the element is constructed before trying to claim a slot,
+         * and then moved into the slot, so a full queue still pays for the construction.
+         * \return true if the element is pushed, false if the queue is full.
+         */
+        template <typename... Args>
+            requires std::constructible_from<T, Args...>
+        bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        {
+            if constexpr (std::is_nothrow_constructible_v<T, Args...>)
+            {
+                const auto [pos, count] = claim(enqueue_pos_, 0, 1);
+                if (count == 0)
+                    return false;
+                publish(pos, static_cast<Args&&>(args)...);
+                return true;
+            }
+            else
+            {
+                T value(static_cast<Args&&>(args)...);
+                return this->try_emplace(std::move(value));
+            }
+        }
+
+        /**
+         * \brief Pushes as many elements from the front of a range as there is room for.
+         * \details The elements pushed by a single call are contiguous in the queue.
+         * \return Number of elements pushed.
+         */
+        template <std::ranges::input_range R>
+            requires std::ranges::sized_range<R> &&
+            std::is_nothrow_constructible_v<T, std::ranges::range_reference_t<R>>
+        std::size_t try_push_bulk(R&& values) noexcept
+        {
+            const auto [pos, count] = claim(enqueue_pos_, 0, static_cast<std::size_t>(std::ranges::size(values)));
+            auto iter = std::ranges::begin(values);
+            for (std::size_t i = 0; i < count; i++, ++iter)
+                publish(pos + i, *iter);
+            return count;
+        }
+
+        /// Pops the front element, returns an empty optional if the queue is empty.
+        [[nodiscard]] std::optional<T> try_pop() noexcept
+        {
+            const auto [pos, count] = claim(dequeue_pos_, 1, 1);
+            if (count == 0)
+                return std::nullopt;
+            slot& s = slot_at(pos);
+            std::optional<T> result(std::in_place, std::move(s.value).get());
+            release(pos, s);
+            return result;
+        }
+
+        /**
+         * \brief Pops up to out.size() elements from the front of the queue, without waiting.
+         * \return Number of elements popped, which are assigned to the front of out.
+         */
+        std::size_t try_pop_bulk(const std::span<T> out) noexcept requires std::is_nothrow_move_assignable_v<T>
+        {
+            const auto [pos, count] = claim(dequeue_pos_, 1, out.size());
+            for (std::size_t i = 0; i < count; i++)
+            {
+                slot& s = slot_at(pos + i);
+                out[i] = std::move(s.value).get();
+                release(pos + i, s);
+            }
+            return count;
+        }
+
+    private:
+        struct alignas(detail::cache_line_size) slot
+        {
+            std::atomic_size_t sequence = 0;
+            manual_lifetime<T> value;
+        };
+
+        std::size_t mask_;
+        std::unique_ptr<slot[]> slots_;
+        alignas(detail::cache_line_size) std::atomic_size_t enqueue_pos_ = 0;
+        alignas(detail::cache_line_size) std::atomic_size_t dequeue_pos_ = 0;
+
+        slot& slot_at(const std::size_t pos) const noexcept { return slots_[pos & mask_]; }
+
+        /*
+         * Claims up to max consecutive positions, whose slots are ready for the current lap. A slot at pos
+         * is ready for a producer if its sequence is pos, and ready for a consumer if it is pos + 1, thus
+         * the offset. If the CAS succeeds, no one else claimed these positions after we've checked the
+         * slots, so the slots are still ready. Returns the first position and the number of positions.
+         */
+        std::pair<std::size_t, std::size_t> claim(
+            std::atomic_size_t& counter, const std::size_t offset, const std::size_t max) const noexcept
+        {
+            if (max == 0)
+                return {0, 0};
+            std::size_t pos = counter.load(std::memory_order::relaxed);
+            while (true)
+            {
+                const std::size_t seq = slot_at(pos).sequence.load(std::memory_order::acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + offset));
+                if (diff < 0) // Full for the producers, or empty for the consumers
+                    return {pos, 0};
+                if (diff > 0) // Someone else has claimed this position, try again
+                {
+                    pos = counter.load(std::memory_order::relaxed);
+                    continue;
+                }
+                std::size_t count = 1;
+                while (count < max &&
+                    slot_at(pos + count).sequence.load(std::memory_order::acquire) == pos + count + offset)
+                    count++;
+                if (counter.compare_exchange_weak(pos, pos + count, std::memory_order::relaxed))
+                    return {pos, count};
+            }
+        }
+
+        template <typename... Args>
+        void publish(const std::size_t pos, Args&&... args) noexcept
+        {
+            slot& s = slot_at(pos);
+            s.value.construct(static_cast<Args&&>(args)...);
+            s.sequence.store(pos + 1, std::memory_order::release);
+        }
+
+        void release(const std::size_t pos, slot& s) noexcept
+        {
+            s.value.destruct();
+            s.sequence.store(pos + mask_ + 1, std::memory_order::release); // Ready for the next lap
+        }
+    };
+} // namespace clu
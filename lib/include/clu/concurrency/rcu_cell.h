@@ -0,0 +1,136 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "hazard_pointer.h"
+#include "../macros.h"
+
+namespace clu
+{
+    /**
+     * \brief A cell holding a read-mostly value, readers get immutable snapshots of it.
+     * \details Reading only protects the current snapshot with a hazard pointer, so the readers
+     * don't write to any shared cache line. Writers copy the current value, modify the copy, and
+     * publish it, the old snapshot is retired into the hazard pointer domain. Writers are serialized
+     * by a mutex, so this is best suited for values which are rarely modified.
+     * \tparam T Type of the value, should be copy constructible for update().
+     */
+    template <typename T>
+    class rcu_cell
+    {
+    private:
+        struct node : hazard_pointer_obj_base<node>
+        {
+            T value;
+
+            // clang-format off
+            template <typename... Ts>
+            explicit node(Ts&&... args): value(static_cast<Ts&&>(args)...) {}
+            // clang-format on
+        };
+
+    public:
+        /// A snapshot of the value, which stays valid even if the cell is updated in the meantime.
+        class snapshot
+        {
+        public:
+            snapshot() noexcept = default;
+            snapshot(snapshot&& other) noexcept: hp_(std::move(other.hp_)), ptr_(std::exchange(other.ptr_, nullptr)) {}
+            snapshot& operator=(snapshot&& other) noexcept
+            {
+                if (&other != this)
+                {
+                    hp_ = std::move(other.hp_);
+                    ptr_ = std::exchange(other.ptr_, nullptr);
+                }
+                return *this;
+            }
+
+            [[nodiscard]] const T* get() const noexcept { return ptr_; }
+            [[nodiscard]] const T& operator*() const noexcept { return *ptr_; }
+            [[nodiscard]] const T* operator->() const noexcept { return ptr_; }
+            [[nodiscard]] explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+        private:
+            friend rcu_cell;
+            hazard_pointer hp_;
+            const T* ptr_ = nullptr;
+        };
+
+        rcu_cell() requires std::default_initializable<T> : rcu_cell(std::in_place) {}
+
+        explicit rcu_cell(T value, hazard_pointer_domain& domain = hazard_pointer_default_domain()):
+            ptr_(new node(static_cast<T&&>(value))), domain_(&domain)
+        {
+        }
+
+        template <typename... Ts>
+        explicit rcu_cell(std::in_place_t, Ts&&... args):
+            ptr_(new node(static_cast<Ts&&>(args)...)), domain_(&hazard_pointer_default_domain())
+        {
+        }
+
+        CLU_IMMOVABLE_TYPE(rcu_cell);
+
+        // Retire instead of deleting, in case some snapshots outlive the cell
+        ~rcu_cell() noexcept { ptr_.load(std::memory_order::relaxed)->retire(*domain_); }
+
+        /// Gets a snapshot of the current value.
+        [[nodiscard]] snapshot read() const
+        {
+            snapshot snap;
+            snap.hp_ = make_hazard_pointer(*domain_);
+            snap.ptr_ = std::addressof(snap.hp_.protect(ptr_)->value);
+            return snap;
+        }
+
+        /// Invokes a function with the current value.
+        template <std::invocable<const T&> F>
+        std::invoke_result_t<F, const T&> read(F&& func) const
+        {
+            const auto snap = read();
+            return std::invoke(static_cast<F&&>(func), *snap);
+        }
+
+        [[nodiscard]] T load() const requires std::copy_constructible<T> { return *read(); }
+
+        /// Replaces the value.
+        void store(T value)
+        {
+            auto fresh = std::make_unique<node>(static_cast<T&&>(value));
+            node* old = nullptr;
+            {
+                std::unique_lock lock(write_mutex_);
+                old = ptr_.exchange(fresh.release(), std::memory_order::acq_rel);
+            }
+            old->retire(*domain_);
+        }
+
+        /**
+         * \brief Modifies a copy of the current value and publishes the copy.
+         * \details The function is invoked exactly once. If it throws, the value is not updated.
+         */
+        template <std::invocable<T&> F>
+            requires std::copy_constructible<T>
+        void update(F&& func)
+        {
+            node* old = nullptr;
+            {
+                std::unique_lock lock(write_mutex_);
+                old = ptr_.load(std::memory_order::relaxed);
+                auto fresh = std::make_unique<node>(std::as_const(old->value));
+                std::invoke(static_cast<F&&>(func), fresh->value);
+                ptr_.store(fresh.release(), std::memory_order::release);
+            }
+            old->retire(*domain_);
+        }
+
+    private:
+        std::atomic<node*> ptr_;
+        hazard_pointer_domain* domain_;
+        std::mutex write_mutex_;
+    };
+} // namespace clu
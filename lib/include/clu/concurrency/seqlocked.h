@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+#include "spinlock.h"
+#include "../macros.h"
+#include "../scope.h"
+
+namespace clu
+{
+    /**
+     * \brief A small trivially copyable value protected by a sequence lock.
+     * \details Readers copy the value optimistically and retry if a writer got in the way, so they
+     * never write to shared memory, and many readers don't slow each other down. Writers are
+     * serialized by a spinlock and are never blocked by readers. The value is stored as relaxed
+     * atomic words, so the racy copies made by the readers are well-defined.
+     * \tparam T Type of the value, should be small since readers copy the whole value on every read.
+     */
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    class seqlocked
+    {
+    public:
+        seqlocked() noexcept requires std::default_initializable<T> : seqlocked(T{}) {}
+        explicit seqlocked(const T& value) noexcept { store_words(value); }
+
+        template <typename... Ts>
+        explicit seqlocked(std::in_place_t, Ts&&... args) noexcept(std::is_nothrow_constructible_v<T, Ts...>):
+            seqlocked(T(static_cast<Ts&&>(args)...))
+        {
+        }
+
+        seqlocked(const seqlocked&) = delete;
+        seqlocked& operator=(const seqlocked&) = delete;
+        ~seqlocked() noexcept = default;
+
+        [[nodiscard]] T load() const noexcept
+        {
+            while (true)
+            {
+                const std::size_t seq = seq_.load(std::memory_order::acquire);
+                if (seq & 1) // A writer is in progress
+                    continue;
+                const T value = load_words();
+                CLU_GCC_WNO_TSAN
+                std::atomic_thread_fence(std::memory_order::acquire);
+                CLU_GCC_RESTORE_WARNING
+                if (seq_.load(std::memory_order::relaxed) == seq)
+                    return value;
+            }
+        }
+
+        [[nodiscard]] T operator*() const noexcept { return load(); }
+
+        void store(const T& value) noexcept
+        {
+            std::unique_lock lock(write_lock_);
+            publish(value);
+        }
+
+        /**
+         * \brief Modifies the value with the writer lock held, the readers see either the old or the new value.
+         * \details The function works on a copy of the value, which is published if the function doesn't throw.
+         */
+        template <std::invocable<T&> F>
+        std::invoke_result_t<F, T&> invoke_with_lock(F&& func)
+        {
+            std::unique_lock lock(write_lock_);
+            T value = load_words(); // No one else is writing
+            scope_success guard([&]() noexcept { publish(value); });
+            return std::invoke(static_cast<F&&>(func), value);
+        }
+
+        /// Invokes a function with a consistent snapshot of the value, without locking.
+        template <std::invocable<const T&> F>
+        std::invoke_result_t<F, const T&> invoke_with_shared_lock(F&& func) const
+        {
+            const T value = load();
+            return std::invoke(static_cast<F&&>(func), value);
+        }
+
+    private:
+        using word = std::size_t;
+        static constexpr std::size_t word_count = (sizeof(T) + sizeof(word) - 1) / sizeof(word);
+
+        std::atomic_size_t seq_ = 0; // Odd when a writer is in progress
+        std::atomic<word> words_[word_count]{};
+        spinlock write_lock_;
+
+        T load_words() const noexcept
+        {
+            word buffer[word_count];
+            for (std::size_t i = 0; i < word_count; i++)
+                buffer[i] = words_[i].load(std::memory_order::relaxed);
+            std::array<unsigned char, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), buffer, sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+
+        void store_words(const T& value) noexcept
+        {
+            word buffer[word_count]{};
+            std::memcpy(buffer, std::addressof(value), sizeof(T));
+            for (std::size_t i = 0; i < word_count; i++)
+                words_[i].store(buffer[i], std::memory_order::relaxed);
+        }
+
+        // Needs to be called with the writer lock held
+        void publish(const T& value) noexcept
+        {
+            const std::size_t seq = seq_.load(std::memory_order::relaxed);
+            seq_.store(seq + 1, std::memory_order::relaxed);
+            CLU_GCC_WNO_TSAN
+            std::atomic_thread_fence(std::memory_order::release); // The odd sequence is visible before the words
+            CLU_GCC_RESTORE_WARNING
+            store_words(value);
+            seq_.store(seq + 2, std::memory_order::release);
+        }
+    };
+
+    template <typename T>
+    seqlocked(T) -> seqlocked<T>;
+} // namespace clu
@@ -1,9 +1,36 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "cache_line.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
 
 namespace clu
 {
+    /// Hints the processor that we are in a spin-wait loop.
+    inline void cpu_relax() noexcept
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+        __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
+    namespace detail
+    {
+        struct mcs_node;
+    } // namespace detail
+
     class spinlock
     {
     public:
@@ -15,4 +42,62 @@ namespace clu
         static constexpr int spin_count = 20;
         std::atomic_flag locked_;
     };
-}
+
+    /**
+     * \brief A test and test-and-set spinlock with exponential backoff.
+     * \details Waiters spin on a plain load so that they don't bounce the cache line around, and back off
+     * exponentially after every failed attempt, yielding the thread when the backoff reaches the limit.
+     */
+    class ttas_spinlock
+    {
+    public:
+        void lock() noexcept;
+        void unlock() noexcept { locked_.store(false, std::memory_order::release); }
+        bool try_lock() noexcept
+        {
+            return !locked_.load(std::memory_order::relaxed) && !locked_.exchange(true, std::memory_order::acquire);
+        }
+
+    private:
+        std::atomic_bool locked_ = false;
+    };
+
+    /**
+     * \brief A fair spinlock which grants the lock in FIFO order.
+     * \details Waiters back off in proportion to the number of waiters before them.
+     */
+    class ticket_spinlock
+    {
+    public:
+        void lock() noexcept;
+        void unlock() noexcept;
+        bool try_lock() noexcept;
+
+    private:
+        alignas(detail::cache_line_size) std::atomic_uint32_t next_ = 0;
+        alignas(detail::cache_line_size) std::atomic_uint32_t serving_ = 0;
+    };
+
+    /**
+     * \brief A fair queue lock where each waiter spins on its own cache line.
+     * \details The queue nodes are cached per thread, so the lock and the unlock of a lock must happen on
+     * the same thread, as with std::mutex. Contention only costs one exchange on the tail pointer per
+     * waiter, and each release only touches the cache line of the next waiter.
+     */
+    class mcs_spinlock
+    {
+    public:
+        mcs_spinlock() noexcept = default;
+        mcs_spinlock(const mcs_spinlock&) = delete;
+        mcs_spinlock& operator=(const mcs_spinlock&) = delete;
+        ~mcs_spinlock() noexcept = default;
+
+        void lock(); ///< May throw std::bad_alloc when the thread needs a new queue node.
+        void unlock() noexcept;
+        bool try_lock();
+
+    private:
+        std::atomic<detail::mcs_node*> tail_ = nullptr;
+        detail::mcs_node* owner_ = nullptr; // Only accessed by the holder of the lock
+    };
+} // namespace clu
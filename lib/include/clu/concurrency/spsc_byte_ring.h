@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include "cache_line.h"
+#include "../assertion.h"
+#include "../buffer.h"
+#include "../macros.h"
+
+namespace clu
+{
+    /**
+     * \brief A wait-free single-producer single-consumer byte ring buffer.
+     * \details The producer writes into the buffer returned by prepare() and then makes the bytes visible
+     * with commit(), the consumer reads from the buffer returned by data() and then frees the space with
+     * consume(). The bytes are never copied by the ring, and nothing is allocated after construction.
+     * If the ring is mirrored, the storage is mapped twice back to back in the virtual address space, so
+     * the buffers are always contiguous even if they wrap around the end of the ring. Otherwise the
+     * buffers stop at the end of the storage, and the rest can be obtained after committing or consuming.
+     */
+    class spsc_byte_ring
+    {
+    public:
+        /**
+         * \brief Constructs an empty ring.
+         * \param capacity Minimum capacity in bytes, the capacity is rounded up to a power of two, and up to
+         * the page allocation granularity if the ring is mirrored.
+         * \param mirrored Whether to try mapping the storage twice, falls back to a plain allocation if the
+         * platform doesn't support it or if the mapping fails.
+         */
+        explicit spsc_byte_ring(std::size_t capacity, bool mirrored = true);
+
+        CLU_IMMOVABLE_TYPE(spsc_byte_ring);
+        ~spsc_byte_ring() noexcept;
+
+        [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+        [[nodiscard]] bool is_mirrored() const noexcept { return mirrored_; }
+
+        // Producer side
+
+        /**
+         * \brief Gets a buffer for writing at most size bytes into.
+         * \return A buffer of at most size bytes, which may be shorter or even empty if the ring is
+         * (nearly) full or, when the ring isn't mirrored, if the free space wraps around.
+         */
+        [[nodiscard]] mutable_buffer prepare(const std::size_t size) noexcept
+        {
+            const std::size_t tail = tail_.load(std::memory_order::relaxed);
+            if (size > capacity() - (tail - head_cache_))
+                head_cache_ = head_.load(std::memory_order::acquire);
+            const std::size_t available = capacity() - (tail - head_cache_);
+            return {ptr_ + (tail & mask_), (std::min)({size, available, contiguous_size(tail)})};
+        }
+
+        /// Makes size bytes written into the prepared buffer visible to the consumer.
+        void commit(const std::size_t size) noexcept
+        {
+            const std::size_t tail = tail_.load(std::memory_order::relaxed);
+            CLU_ASSERT(size <= capacity() - (tail - head_cache_), "committing more bytes than prepared");
+            tail_.store(tail + size, std::memory_order::release);
+        }
+
+        // Consumer side
+
+        /// Gets a buffer of the readable bytes, which may not be all of them if the ring isn't mirrored.
+        [[nodiscard]] const_buffer data() noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order::relaxed);
+            tail_cache_ = tail_.load(std::memory_order::acquire);
+            return {ptr_ + (head & mask_), (std::min)(tail_cache_ - head, contiguous_size(head))};
+        }
+
+        /// Frees size bytes from the front of the readable bytes.
+        void consume(const std::size_t size) noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order::relaxed);
+            CLU_ASSERT(tail_cache_ - head >= size, "consuming more bytes than readable");
+            head_.store(head + size, std::memory_order::release);
+        }
+
+    private:
+        std::byte* ptr_ = nullptr;
+        std::size_t mask_ = 0;
+        bool mirrored_ = false;
+        alignas(detail::cache_line_size) std::atomic_size_t head_ = 0;
+        std::size_t tail_cache_ = 0; // Consumer's view of tail_
+        alignas(detail::cache_line_size) std::atomic_size_t tail_ = 0;
+        std::size_t head_cache_ = 0; // Producer's view of head_
+
+        std::size_t contiguous_size(const std::size_t pos) const noexcept
+        {
+            return mirrored_ ? capacity() : capacity() - (pos & mask_);
+        }
+    };
+} // namespace clu
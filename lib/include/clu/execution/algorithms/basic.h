@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../utility.h"
+#include "../schedulers.h"
 #include "../../copy_elider.h"
 #include "../../piper.h"
 
@@ -909,6 +910,228 @@ namespace clu::exec
             };
         } // namespace into_var
 
+        namespace rpt
+        {
+            // Predicate of repeat_n, the child sender is repeated until the count drops to zero
+            struct countdown
+            {
+                std::size_t remaining;
+                constexpr bool operator()() noexcept { return --remaining == 0; }
+            };
+
+            template <typename S, typename R, typename F>
+            class ops_t_;
+
+            template <typename S, typename R, typename F>
+            using ops_t = ops_t_<S, std::remove_cvref_t<R>, F>;
+
+            template <typename S, typename R, typename F>
+            class recv_t_ : public receiver_adaptor<recv_t_<S, R, F>>
+            {
+            public:
+                explicit recv_t_(ops_t<S, R, F>* ops) noexcept: ops_(ops) {}
+
+                // Propagate get_env, set_error, set_stopped to the base receiver
+                const R& base() const& noexcept;
+                R&& base() && noexcept;
+
+                // The values of each iteration are discarded
+                template <typename... Ts>
+                void set_value(Ts&&...) && noexcept;
+
+            private:
+                ops_t<S, R, F>* ops_;
+            };
+
+            // Receiver of the trampoline scheduler sender between two iterations
+            template <typename S, typename R, typename F>
+            class trmp_recv_t_ : public receiver_adaptor<trmp_recv_t_<S, R, F>>
+            {
+            public:
+                explicit trmp_recv_t_(ops_t<S, R, F>* ops) noexcept: ops_(ops) {}
+
+                const R& base() const& noexcept;
+                R&& base() && noexcept;
+                void set_value() && noexcept;
+
+            private:
+                ops_t<S, R, F>* ops_;
+            };
+
+            template <typename S, typename R, typename F>
+            class ops_t_
+            {
+            public:
+                // clang-format off
+                template <typename S2, typename R2, typename F2>
+                ops_t_(S2&& snd, R2&& recv, F2&& pred):
+                    snd_(static_cast<S2&&>(snd)),
+                    recv_(static_cast<R2&&>(recv)),
+                    pred_(static_cast<F2&&>(pred)) {}
+                // clang-format on
+
+                const R& get_recv() const noexcept { return recv_; }
+                R&& get_recv() noexcept { return static_cast<R&&>(recv_); }
+
+                void iteration_done() noexcept
+                {
+                    try
+                    {
+                        if (std::invoke(pred_))
+                        {
+                            ops_.template emplace<0>(); // Destroy the child operation state in time
+                            exec::set_value(static_cast<R&&>(recv_));
+                            return;
+                        }
+                    }
+                    catch (...)
+                    {
+                        exec::set_error(static_cast<R&&>(recv_), std::current_exception());
+                        return;
+                    }
+                    // Bounce through the trampoline to avoid unbounded recursion when the child completes inline.
+                    // Emplacing the trampoline operation destroys the finished child operation state in place.
+                    exec::start(ops_.template emplace<trmp_ops_t>(copy_elider{[&] { //
+                        return exec::connect(exec::schedule(trampoline_scheduler{}), trmp_recv_t_<S, R, F>(this));
+                    }}));
+                }
+
+                void start_iteration() noexcept
+                {
+                    try
+                    {
+                        exec::start(ops_.template emplace<child_ops_t>(
+                            copy_elider{[&] { return exec::connect(std::as_const(snd_), recv_t_<S, R, F>(this)); }}));
+                    }
+                    catch (...)
+                    {
+                        exec::set_error(static_cast<R&&>(recv_), std::current_exception());
+                    }
+                }
+
+                void tag_invoke(start_t) noexcept
+                {
+                    if constexpr (std::is_same_v<F, countdown>)
+                    {
+                        if (pred_.remaining == 0) // repeat_n(snd, 0)
+                        {
+                            exec::set_value(static_cast<R&&>(recv_));
+                            return;
+                        }
+                    }
+                    start_iteration();
+                }
+
+            private:
+                using child_ops_t = connect_result_t<const S&, recv_t_<S, R, F>>;
+                using trmp_ops_t = connect_result_t<schedule_result_t<trampoline_scheduler>, trmp_recv_t_<S, R, F>>;
+
+                CLU_NO_UNIQUE_ADDRESS S snd_;
+                CLU_NO_UNIQUE_ADDRESS R recv_;
+                CLU_NO_UNIQUE_ADDRESS F pred_;
+                ops_variant<std::monostate, child_ops_t, trmp_ops_t> ops_;
+            };
+
+            // clang-format off
+            template <typename S, typename R, typename F>
+            const R& recv_t_<S, R, F>::base() const& noexcept { return std::as_const(*ops_).get_recv(); }
+            template <typename S, typename R, typename F>
+            R&& recv_t_<S, R, F>::base() && noexcept { return ops_->get_recv(); }
+            template <typename S, typename R, typename F>
+            const R& trmp_recv_t_<S, R, F>::base() const& noexcept { return std::as_const(*ops_).get_recv(); }
+            template <typename S, typename R, typename F>
+            R&& trmp_recv_t_<S, R, F>::base() && noexcept { return ops_->get_recv(); }
+            // clang-format on
+
+            template <typename S, typename R, typename F>
+            template <typename... Ts>
+            void recv_t_<S, R, F>::set_value(Ts&&...) && noexcept
+            {
+                ops_->iteration_done();
+            }
+
+            template <typename S, typename R, typename F>
+            void trmp_recv_t_<S, R, F>::set_value() && noexcept
+            {
+                ops_->start_iteration();
+            }
+
+            template <typename S, typename F>
+            class snd_t_
+            {
+            public:
+                using is_sender = void;
+
+                // clang-format off
+                template <typename S2, typename F2>
+                snd_t_(S2&& snd, F2&& pred):
+                    snd_(static_cast<S2&&>(snd)), pred_(static_cast<F2&&>(pred)) {}
+                // clang-format on
+
+                template <receiver R>
+                auto tag_invoke(connect_t, R&& recv) &&
+                {
+                    return ops_t<S, R, F>(static_cast<S&&>(snd_), static_cast<R&&>(recv), static_cast<F&&>(pred_));
+                }
+
+                template <receiver R>
+                auto tag_invoke(connect_t, R&& recv) const&
+                {
+                    return ops_t<S, R, F>(snd_, static_cast<R&&>(recv), pred_);
+                }
+
+                template <typename Env>
+                constexpr make_completion_signatures<const S&, Env,
+                    completion_signatures<set_value_t(), set_error_t(std::exception_ptr), set_stopped_t()>,
+                    meta::constant_q<completion_signatures<>>::fn>
+                tag_invoke(get_completion_signatures_t, Env) const noexcept
+                {
+                    return {};
+                }
+
+            private:
+                CLU_NO_UNIQUE_ADDRESS S snd_;
+                CLU_NO_UNIQUE_ADDRESS F pred_;
+            };
+
+            template <typename S, typename F>
+            using snd_t = snd_t_<std::remove_cvref_t<S>, std::decay_t<F>>;
+
+            struct repeat_effect_until_t
+            {
+                template <sender S, typename F>
+                    requires std::invocable<std::decay_t<F>&> &&
+                    boolean_testable<std::invoke_result_t<std::decay_t<F>&>>
+                CLU_STATIC_CALL_OPERATOR(auto)
+                (S&& snd, F&& pred)
+                {
+                    return snd_t<S, F>(static_cast<S&&>(snd), static_cast<F&&>(pred));
+                }
+
+                template <typename F>
+                CLU_STATIC_CALL_OPERATOR(auto)
+                (F&& pred)
+                {
+                    return clu::make_piper(clu::bind_back(repeat_effect_until_t{}, static_cast<F&&>(pred)));
+                }
+            };
+
+            struct repeat_n_t
+            {
+                template <sender S>
+                CLU_STATIC_CALL_OPERATOR(auto)
+                (S&& snd, const std::size_t count)
+                {
+                    return snd_t<S, countdown>(static_cast<S&&>(snd), countdown{count});
+                }
+
+                CLU_STATIC_CALL_OPERATOR(auto)(const std::size_t count)
+                {
+                    return clu::make_piper(clu::bind_back(repeat_n_t{}, count));
+                }
+            };
+        } // namespace rpt
+
 #undef CLU_EXEC_FWD_ENV
     } // namespace detail
 
@@ -926,6 +1149,8 @@ namespace clu::exec
     using detail::let::let_stopped_t;
     using detail::qry_val::with_query_value_t;
     using detail::into_var::into_variant_t;
+    using detail::rpt::repeat_effect_until_t;
+    using detail::rpt::repeat_n_t;
 
     inline constexpr just_t just{};
     inline constexpr just_error_t just_error{};
@@ -942,4 +1167,6 @@ namespace clu::exec
     inline constexpr let_stopped_t let_stopped{};
     inline constexpr with_query_value_t with_query_value{};
     inline constexpr into_variant_t into_variant{};
+    inline constexpr repeat_effect_until_t repeat_effect_until{};
+    inline constexpr repeat_n_t repeat_n{};
 } // namespace clu::exec
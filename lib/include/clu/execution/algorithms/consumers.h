@@ -4,6 +4,7 @@
 
 #include "basic.h"
 #include "../run_loop.h"
+#include "../../expected.h"
 
 namespace clu::exec
 {
@@ -255,11 +256,137 @@ namespace clu::this_thread
                 }
             }
         };
+
+        template <typename... Ts>
+        struct value_or_empty : single_type<Ts...> {};
+        template <>
+        struct value_or_empty<> : std::type_identity<std::tuple<>> {};
+
+        // Senders that never complete with a value are also allowed here
+        template <typename S>
+        using expected_value_t = typename exec::value_types_of_t<S, env_t, //
+            exec::detail::decayed_tuple, value_or_empty>::type;
+
+        template <typename... Es>
+        struct error_or_variant : std::type_identity<std::variant<Es...>> {};
+        template <typename E>
+        struct error_or_variant<E> : std::type_identity<E> {};
+        template <>
+        struct error_or_variant<> : std::type_identity<std::monostate> {};
+
+        template <typename... Es>
+        using decayed_list = type_list<std::decay_t<Es>...>;
+
+        // The error type of a sync_wait_expected result, the only error type if the sender sends exactly one,
+        // a variant of all the possible error types otherwise
+        template <typename S>
+        using error_t = typename meta::unpack_invoke< //
+            meta::unique_l<exec::error_types_of_t<S, env_t, decayed_list>>, meta::quote<error_or_variant>>::type;
+        template <typename S>
+        using expected_t = expected<expected_value_t<S>, error_t<S>>;
+        template <typename S>
+        using expected_result_t = std::optional<expected_t<S>>;
+        // The exception_ptr alternative only stores exceptions thrown while storing the value or the error
+        template <typename S>
+        using expected_variant_t = std::variant<std::monostate, expected_value_t<S>, error_t<S>, //
+            std::exception_ptr, exec::set_stopped_t>;
+
+        template <typename S>
+        class expected_recv_t_
+        {
+        public:
+            using is_receiver = void;
+
+            expected_recv_t_(run_loop* loop, expected_variant_t<S>* ptr): loop_(loop), ptr_(ptr) {}
+
+            env_t tag_invoke(get_env_t) const noexcept { return {loop_->get_scheduler()}; }
+
+            template <typename... Ts>
+                requires std::constructible_from<expected_value_t<S>, Ts...>
+            void tag_invoke(exec::set_value_t, Ts&&... args) && noexcept
+            {
+                try
+                {
+                    ptr_->template emplace<1>(static_cast<Ts&&>(args)...);
+                }
+                catch (...)
+                {
+                    ptr_->template emplace<3>(std::current_exception());
+                }
+                loop_->finish();
+            }
+
+            template <typename E>
+            void tag_invoke(exec::set_error_t, E&& error) && noexcept
+            {
+                try
+                {
+                    ptr_->template emplace<2>(static_cast<E&&>(error));
+                }
+                catch (...)
+                {
+                    ptr_->template emplace<3>(std::current_exception());
+                }
+                loop_->finish();
+            }
+
+            void tag_invoke(exec::set_stopped_t) && noexcept
+            {
+                ptr_->template emplace<4>();
+                loop_->finish();
+            }
+
+        private:
+            run_loop* loop_;
+            expected_variant_t<S>* ptr_;
+        };
+
+        template <typename S>
+        using expected_recv_t = expected_recv_t_<std::remove_cvref_t<S>>;
+
+        // clang-format off
+        template <typename S>
+        concept sync_waitable_expected_sender =
+            exec::sender_in<S, env_t> &&
+            requires { typename expected_result_t<S>; };
+        // clang-format on
+
+        struct sync_wait_expected_t
+        {
+            template <sync_waitable_expected_sender S>
+            CLU_STATIC_CALL_OPERATOR(expected_result_t<S>)
+            (S&& snd)
+            {
+                if constexpr (tag_invocable<sync_wait_expected_t, S>)
+                {
+                    static_assert(std::is_same_v<tag_invoke_result_t<sync_wait_expected_t, S>, expected_result_t<S>>);
+                    return clu::tag_invoke(sync_wait_expected_t{}, static_cast<S&&>(snd));
+                }
+                else
+                {
+                    run_loop ctx;
+                    expected_variant_t<S> result;
+                    auto ops = exec::connect(static_cast<S&&>(snd), expected_recv_t<S>(&ctx, &result));
+                    exec::start(ops);
+                    ctx.run();
+                    switch (result.index())
+                    {
+                        case 1: return expected_t<S>(std::in_place, std::get<1>(std::move(result)));
+                        case 2: return expected_t<S>(unexpect, std::get<2>(std::move(result)));
+                        case 3: std::rethrow_exception(std::get<3>(std::move(result)));
+                        case 4: return std::nullopt;
+                        default: unreachable();
+                    }
+                }
+            }
+        };
     } // namespace detail::sync_wait
 
     using detail::sync_wait::sync_wait_t;
     using detail::sync_wait::sync_wait_with_variant_t;
+    using detail::sync_wait::sync_wait_expected_t;
 
     inline constexpr sync_wait_t sync_wait{};
     inline constexpr sync_wait_with_variant_t sync_wait_with_variant{};
+    inline constexpr sync_wait_expected_t sync_wait_expected{};
 } // namespace clu::this_thread
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <ranges>
+#include <vector>
+
 #include "basic.h"
+#include "../../scope.h"
 
 namespace clu::exec
 {
@@ -180,7 +184,6 @@ namespace clu::exec
                 using error_t = meta::unpack_invoke< //
                     meta::flatten<error_types_of_t<Ts, env_of_t<R>, type_list>..., type_list<std::exception_ptr>>, //
                     meta::quote<nullable_variant>>;
-                using callback_t = typename stop_token_of_t<env_of_t<R>>::template callback_type<stop_callback>;
 
             private:
                 R recv_;
@@ -189,7 +192,7 @@ namespace clu::exec
                 children_ops_t<R, Ts...> children_;
                 std::atomic_size_t finished_count_{};
                 std::atomic<final_signal> signal_{};
-                std::optional<callback_t> callback_;
+                CLU_NO_UNIQUE_ADDRESS optional_stop_callback<stop_token_of_t<env_of_t<R>>, stop_callback> callback_;
                 CLU_NO_UNIQUE_ADDRESS values_t values_;
                 error_t error_;
 
@@ -337,6 +340,323 @@ namespace clu::exec
             };
         } // namespace when_all
 
+        namespace when_all_rng
+        {
+            template <typename Env>
+            using env_t = adapted_env_t<Env, query_value<get_stop_token_t, in_place_stop_token>>;
+            template <typename R>
+            using recv_env_t = env_t<env_of_t<R>>;
+
+            template <typename Env, typename T>
+            using alloc_for_t =
+                typename std::allocator_traits<call_result_t<get_allocator_t, Env>>::template rebind_alloc<T>;
+            template <typename Env, typename T>
+            using result_vector_t = std::vector<T, alloc_for_t<Env, T>>;
+
+            template <typename S, typename Env>
+            using value_t = single_sender_value_type<S, env_t<Env>>;
+            template <typename S, typename Env>
+            using value_sig_t = conditional_t<std::is_void_v<value_t<S, Env>>, //
+                set_value_t(), set_value_t(result_vector_t<Env, value_t<S, Env>>&&)>;
+
+            template <typename R, typename S>
+            class ops_t_;
+
+            template <typename R, typename S>
+            using ops_t = ops_t_<std::remove_cvref_t<R>, S>;
+
+            template <typename R, typename S>
+            class recv_t_
+            {
+            public:
+                using is_receiver = void;
+
+                recv_t_(ops_t<R, S>* ops, const std::size_t index) noexcept: ops_(ops), index_(index) {}
+
+                const recv_env_t<R>& tag_invoke(get_env_t) const noexcept;
+
+                template <completion_cpo SetCpo, typename... Args>
+                void tag_invoke(SetCpo, Args&&... args) && noexcept
+                {
+                    ops_->set(index_, SetCpo{}, static_cast<Args&&>(args)...);
+                }
+
+            private:
+                ops_t<R, S>* ops_;
+                std::size_t index_;
+            };
+
+            template <typename R, typename S>
+            using recv_t = recv_t_<std::remove_cvref_t<R>, S>;
+
+            enum class final_signal
+            {
+                value,
+                error,
+                stopped
+            };
+
+            template <typename R, typename S>
+            class ops_t_
+            {
+            public:
+                template <forwarding<R> R2, typename Rng>
+                ops_t_(R2&& recv, Rng&& snds):
+                    recv_(static_cast<R2&&>(recv)),
+                    env_(clu::adapt_env(get_env(recv_), query_value{get_stop_token, stop_src_.get_token()})),
+                    size_(static_cast<std::size_t>(std::ranges::distance(snds))),
+                    values_(make_values(size_, get_allocator(get_env(recv_))))
+                {
+                    // All the child operation states live in one contiguous block
+                    children_alloc_t alloc(get_allocator(get_env(recv_)));
+                    children_ = children_traits::allocate(alloc, size_);
+                    std::size_t i = 0;
+                    try
+                    {
+                        for (auto&& snd : snds)
+                        {
+                            ::new (static_cast<void*>(children_ + i))
+                                child_ops_t(exec::connect(static_cast<S&&>(snd), recv_t<R, S>(this, i)));
+                            ++i;
+                        }
+                    }
+                    catch (...)
+                    {
+                        destroy_children(i);
+                        throw;
+                    }
+                }
+
+                ops_t_(const ops_t_&) = delete;
+                ops_t_& operator=(const ops_t_&) = delete;
+                ~ops_t_() noexcept { destroy_children(size_); }
+
+                const auto& get_recv_env() const noexcept { return env_; }
+
+                template <typename... Us>
+                void set(const std::size_t index, set_value_t, [[maybe_unused]] Us&&... values) noexcept
+                {
+                    if constexpr (sizeof...(Us) != 0)
+                        // relaxed since dependency is taken care of by the counter
+                        if (signal_.load(std::memory_order::relaxed) == final_signal::value)
+                        {
+                            try
+                            {
+                                values_[index].emplace(static_cast<Us&&>(values)...);
+                            }
+                            catch (...)
+                            {
+                                set(index, set_error, std::current_exception());
+                                return; // Counter increment taken care of by set(set_error_t, E&&)
+                            }
+                        }
+                    increase_counter(); // Arrives
+                }
+
+                template <typename E>
+                void set(std::size_t, set_error_t, E&& error) noexcept
+                {
+                    // Only do things if we are the first one arriving with a non-value signal
+                    if (final_signal expected = final_signal::value;
+                        signal_.compare_exchange_strong(expected, final_signal::error, std::memory_order::relaxed))
+                    {
+                        stop_src_.request_stop(); // Cancel sibling operations
+                        try
+                        {
+                            error_.template emplace<std::decay_t<E>>(static_cast<E&&>(error));
+                        }
+                        catch (...)
+                        {
+                            error_.template emplace<std::exception_ptr>(std::current_exception());
+                        }
+                    }
+                    increase_counter(); // Arrives
+                }
+
+                void set(std::size_t, set_stopped_t) noexcept
+                {
+                    if (final_signal expected = final_signal::value;
+                        signal_.compare_exchange_strong(expected, final_signal::stopped, std::memory_order::relaxed))
+                        stop_src_.request_stop(); // Cancel sibling operations
+                    increase_counter(); // Arrives
+                }
+
+                void tag_invoke(start_t) noexcept
+                {
+                    if (size_ == 0) // Nothing to wait for
+                    {
+                        send_values();
+                        return;
+                    }
+                    callback_.emplace( // Propagate stop signal
+                        get_stop_token(get_env(recv_)), stop_callback{stop_src_});
+                    if (stop_src_.stop_requested()) // Shortcut when the operation is preemptively stopped
+                    {
+                        callback_.reset();
+                        exec::set_stopped(static_cast<R&&>(recv_));
+                        return;
+                    }
+                    for (std::size_t i = 0; i < size_; i++) exec::start(children_[i]);
+                }
+
+            private:
+                struct stop_callback
+                {
+                    in_place_stop_source& stop_src;
+                    void operator()() const noexcept { stop_src.request_stop(); }
+                };
+
+                using env_type = env_of_t<R>;
+                using value_type = value_t<S, env_type>;
+                using child_ops_t = connect_result_t<S, recv_t<R, S>>;
+                using children_alloc_t = alloc_for_t<env_type, child_ops_t>;
+                using children_traits = std::allocator_traits<children_alloc_t>;
+                using values_t = conditional_t<std::is_void_v<value_type>, std::monostate,
+                    std::vector<std::optional<value_type>, alloc_for_t<env_type, std::optional<value_type>>>>;
+                using error_t = meta::unpack_invoke< //
+                    meta::flatten<error_types_of_t<S, env_type, type_list>, type_list<std::exception_ptr>>, //
+                    meta::quote<nullable_variant>>;
+
+                R recv_;
+                in_place_stop_source stop_src_;
+                recv_env_t<R> env_;
+                std::size_t size_;
+                child_ops_t* children_ = nullptr;
+                std::atomic_size_t finished_count_{};
+                std::atomic<final_signal> signal_{};
+                CLU_NO_UNIQUE_ADDRESS optional_stop_callback<stop_token_of_t<env_type>, stop_callback> callback_;
+                CLU_NO_UNIQUE_ADDRESS values_t values_;
+                error_t error_;
+
+                template <typename A>
+                static values_t make_values(const std::size_t size, const A& alloc)
+                {
+                    if constexpr (std::is_void_v<value_type>)
+                        return {};
+                    else
+                        return values_t(size, typename values_t::allocator_type(alloc));
+                }
+
+                void destroy_children(const std::size_t constructed) noexcept
+                {
+                    if (!children_)
+                        return;
+                    for (std::size_t i = 0; i < constructed; i++) children_[i].~child_ops_t();
+                    children_alloc_t alloc(get_allocator(get_env(recv_)));
+                    children_traits::deallocate(alloc, children_, size_);
+                    children_ = nullptr;
+                }
+
+                void increase_counter() noexcept
+                {
+                    if (finished_count_.fetch_add(1, std::memory_order::acq_rel) + 1 == size_)
+                        send_results();
+                }
+
+                // The child operations have ended, send the aggregated result to the receiver
+                void send_results() noexcept
+                {
+                    callback_.reset(); // The stop callback won't be needed
+                    switch (signal_)
+                    {
+                        case final_signal::value: send_values(); return;
+                        case final_signal::error:
+                            std::visit(
+                                [&]<typename E>(E&& error) noexcept
+                                {
+                                    if constexpr (std::is_same_v<E, std::monostate>)
+                                        unreachable();
+                                    else
+                                        exec::set_error(static_cast<R&&>(recv_), static_cast<E&&>(error));
+                                },
+                                std::move(error_));
+                            return;
+                        case final_signal::stopped: exec::set_stopped(static_cast<R&&>(recv_)); return;
+                        default: unreachable();
+                    }
+                }
+
+                void send_values() noexcept
+                {
+                    if constexpr (std::is_void_v<value_type>)
+                        exec::set_value(static_cast<R&&>(recv_));
+                    else
+                    {
+                        result_vector_t<env_type, value_type> results(get_allocator(get_env(recv_)));
+                        try
+                        {
+                            results.reserve(size_);
+                            for (auto& opt : values_) results.push_back(std::move(*opt));
+                        }
+                        catch (...)
+                        {
+                            exec::set_error(static_cast<R&&>(recv_), std::current_exception());
+                            return;
+                        }
+                        exec::set_value(static_cast<R&&>(recv_), std::move(results));
+                    }
+                }
+            };
+
+            template <typename R, typename S>
+            const recv_env_t<R>& recv_t_<R, S>::tag_invoke(get_env_t) const noexcept
+            {
+                return ops_->get_recv_env();
+            }
+
+            template <typename Rng>
+            class snd_t_
+            {
+            public:
+                using is_sender = void;
+
+                // clang-format off
+                template <typename Rng2>
+                explicit snd_t_(Rng2&& snds): snds_(static_cast<Rng2&&>(snds)) {}
+                // clang-format on
+
+                template <receiver R>
+                auto tag_invoke(connect_t, R&& recv) &&
+                {
+                    return ops_t<R, sender_type>(static_cast<R&&>(recv), std::move(snds_));
+                }
+
+                template <typename Env>
+                constexpr static auto tag_invoke(get_completion_signatures_t, Env&&) noexcept
+                {
+                    return make_completion_signatures<sender_type, env_t<Env>,
+                        completion_signatures<value_sig_t<sender_type, Env>, //
+                            set_error_t(std::exception_ptr), set_stopped_t()>,
+                        meta::constant_q<completion_signatures<>>::fn>{};
+                }
+
+            private:
+                using sender_type = std::ranges::range_value_t<Rng>;
+                Rng snds_;
+            };
+
+            template <typename Rng>
+            using snd_t = snd_t_<std::decay_t<Rng>>;
+
+            struct when_all_range_t
+            {
+                template <std::ranges::forward_range Rng>
+                    requires sender<std::ranges::range_value_t<Rng>>
+                CLU_STATIC_CALL_OPERATOR(auto)
+                (Rng&& snds)
+                {
+                    if constexpr (tag_invocable<when_all_range_t, Rng>)
+                    {
+                        static_assert(sender<tag_invoke_result_t<when_all_range_t, Rng>>,
+                            "customization of when_all_range should return a sender");
+                        return clu::tag_invoke(when_all_range_t{}, static_cast<Rng&&>(snds));
+                    }
+                    else
+                        return snd_t<Rng>(static_cast<Rng&&>(snds));
+                }
+            };
+        } // namespace when_all_rng
+
         namespace when_any
         {
             template <typename Env>
@@ -503,7 +823,6 @@ namespace clu::exec
                 using error_t = meta::unpack_invoke< //
                     meta::flatten<error_types_of_t<Ts, env_of_t<R>, type_list>..., type_list<std::exception_ptr>>, //
                     meta::quote<nullable_variant>>;
-                using callback_t = typename stop_token_of_t<env_of_t<R>>::template callback_type<stop_callback>;
 
                 R recv_;
                 in_place_stop_source stop_src_;
@@ -511,7 +830,7 @@ namespace clu::exec
                 children_ops_t<R, Ts...> children_;
                 std::atomic_size_t finished_count_{};
                 std::atomic<final_signal> signal_{};
-                std::optional<callback_t> callback_;
+                CLU_NO_UNIQUE_ADDRESS optional_stop_callback<stop_token_of_t<env_of_t<R>>, stop_callback> callback_;
                 CLU_NO_UNIQUE_ADDRESS values_t values_;
                 error_t error_;
 
@@ -758,14 +1077,13 @@ namespace clu::exec
                     in_place_stop_source& stop_src;
                     void operator()() const noexcept { stop_src.request_stop(); }
                 };
-                using callback_t = typename stop_token_of_t<env_of_t<R>>::template callback_type<stop_callback>;
 
                 R recv_;
                 in_place_stop_source stop_src_;
                 recv_env_t<R> env_;
                 std::atomic_uint8_t counter_{0};
                 storage_variant<S, T, R> storage_;
-                std::optional<callback_t> callback_;
+                CLU_NO_UNIQUE_ADDRESS optional_stop_callback<stop_token_of_t<env_of_t<R>>, stop_callback> callback_;
                 connect_result_t<S, recv_t<S, T, R>> src_ops_;
                 connect_result_t<T, trig_recv_t<S, T, R>> trig_ops_;
 
@@ -873,7 +1191,6 @@ namespace clu::exec
             struct shared_state
             {
                 using env_t = std::remove_cvref_t<env_of_t<R>>;
-                using callback_type = typename stop_token_of_t<env_t>::template callback_type<stop_callback<S, R, F>>;
 
                 template <typename... Ts>
                 using ops_type_of_values = connect_result_t<std::invoke_result_t<F, Ts...>, cleanup_recv_t<S, R, F>>;
@@ -884,7 +1201,7 @@ namespace clu::exec
                 std::atomic_flag value_sent;
                 ops_optional<connect_result_t<S, recv_t<S, R, F>>> ops;
                 value_types_of_t<S, env_of_t<R>, ops_type_of_values, nullable_ops_variant> cleanup_ops;
-                std::optional<callback_type> cb;
+                CLU_NO_UNIQUE_ADDRESS optional_stop_callback<stop_token_of_t<env_t>, stop_callback<S, R, F>> cb;
 
                 // clang-format off
                 template <typename R2, typename F2>
@@ -1086,19 +1403,389 @@ namespace clu::exec
 
         namespace split
         {
-            // TODO: implement
+            using env_t = adapted_env_t<empty_env, query_value<get_stop_token_t, in_place_stop_token>>;
+
+            template <typename... Ts>
+            using value_result = decayed_tuple<set_value_t, Ts...>;
+            template <typename... Es>
+            using error_results = type_list<decayed_tuple<set_error_t, Es>...>;
+            using exception_result = std::tuple<set_error_t, std::exception_ptr>;
+            using stopped_result = std::tuple<set_stopped_t>;
+
+            // Every possible completion of the shared sender, stored as (cpo, args...)
+            template <typename S>
+            using results_t = meta::unique_l<meta::flatten< //
+                value_types_of_t<S, env_t, value_result, type_list>, //
+                error_types_of_t<S, env_t, error_results>, //
+                type_list<exception_result, stopped_result>>>;
+
+            template <typename S>
+            using result_t = meta::unpack_invoke<results_t<S>, meta::quote<nullable_variant>>;
+
+            // split sends const references to the shared values and copies of the error,
+            // ensure_started moves the result out
+            template <typename Tup, bool Move>
+            struct result_sig;
+            template <typename... Ts>
+            struct result_sig<std::tuple<set_value_t, Ts...>, false>
+            {
+                using type = set_value_t(const Ts&...);
+            };
+            template <typename Cpo, typename... Ts>
+            struct result_sig<std::tuple<Cpo, Ts...>, false>
+            {
+                using type = Cpo(Ts...);
+            };
+            template <typename Cpo, typename... Ts>
+            struct result_sig<std::tuple<Cpo, Ts...>, true>
+            {
+                using type = Cpo(Ts&&...);
+            };
+
+            template <bool Move>
+            struct sigs_of_results
+            {
+                template <typename... Tups>
+                using fn = completion_signatures<typename result_sig<Tups, Move>::type...>;
+            };
+
+            template <typename S, bool Move>
+            using sigs_t = meta::unpack_invoke<results_t<S>, sigs_of_results<Move>>;
+
+            class waiter_base
+            {
+            public:
+                waiter_base* next = nullptr;
+
+                waiter_base() noexcept = default;
+                CLU_IMMOVABLE_TYPE(waiter_base);
+                virtual void notify() noexcept = 0;
+
+            protected:
+                ~waiter_base() noexcept = default;
+            };
+
+            template <typename S>
+            class shared_state;
+
+            template <typename S>
+            class recv_t_
+            {
+            public:
+                using is_receiver = void;
+
+                explicit recv_t_(shared_state<S>* state) noexcept: state_(state) {}
+
+                const env_t& tag_invoke(get_env_t) const noexcept;
+
+                template <completion_cpo SetCpo, typename... Args>
+                void tag_invoke(SetCpo, Args&&... args) && noexcept
+                {
+                    state_->complete(SetCpo{}, static_cast<Args&&>(args)...);
+                }
+
+            private:
+                shared_state<S>* state_;
+            };
+
+            // Intrusively reference counted state shared by every copy of the sender and every consumer
+            template <typename S>
+            class shared_state
+            {
+            public:
+                // clang-format off
+                template <typename S2>
+                explicit shared_state(S2&& snd):
+                    env_(clu::adapt_env(empty_env{}, query_value{get_stop_token, stop_src_.get_token()})),
+                    child_(exec::connect(static_cast<S2&&>(snd), recv_t_<S>(this))) {}
+                // clang-format on
+
+                CLU_IMMOVABLE_TYPE(shared_state);
+
+                void add_ref() noexcept { refs_.fetch_add(1, std::memory_order::relaxed); }
+                void release() noexcept
+                {
+                    if (refs_.fetch_sub(1, std::memory_order::acq_rel) == 1)
+                        delete this;
+                }
+
+                const env_t& get_env() const noexcept { return env_; }
+                result_t<S>& result() noexcept { return result_; }
+                void request_stop() noexcept { stop_src_.request_stop(); }
+
+                // Starts the child operation if it hasn't been started yet,
+                // the running child operation holds a reference to the state
+                void start() noexcept
+                {
+                    if (started_.test_and_set(std::memory_order::relaxed))
+                        return;
+                    add_ref();
+                    exec::start(child_);
+                }
+
+                // Pushes a waiter onto the waiting stack,
+                // returns false if the result is already available
+                bool add_waiter(waiter_base& waiter) noexcept
+                {
+                    void* expected = waiting_.load(std::memory_order::acquire);
+                    while (true)
+                    {
+                        if (expected == this)
+                            return false;
+                        waiter.next = static_cast<waiter_base*>(expected);
+                        if (waiting_.compare_exchange_weak(
+                                expected, &waiter, std::memory_order::release, std::memory_order::acquire))
+                            return true;
+                    }
+                }
+
+                template <typename Cpo, typename... Args>
+                void complete(Cpo, Args&&... args) noexcept
+                {
+                    try
+                    {
+                        result_.template emplace<decayed_tuple<Cpo, Args...>>(Cpo{}, static_cast<Args&&>(args)...);
+                    }
+                    catch (...)
+                    {
+                        result_.template emplace<exception_result>(set_error, std::current_exception());
+                    }
+                    // Publish the result and wake up everyone that is waiting
+                    auto* head = static_cast<waiter_base*>(waiting_.exchange(this, std::memory_order::acq_rel));
+                    while (head)
+                        std::exchange(head, head->next)->notify();
+                    release(); // Drop the reference held by the child operation
+                }
+
+            private:
+                using child_ops_t = connect_result_t<S, recv_t_<S>>;
+
+                std::atomic_size_t refs_{1};
+                std::atomic_flag started_;
+                // Stores this when the result is ready,
+                // stores the latest waiting operation state (or nullptr) otherwise
+                std::atomic<void*> waiting_{nullptr};
+                in_place_stop_source stop_src_;
+                env_t env_;
+                result_t<S> result_;
+                child_ops_t child_;
+            };
+
+            template <typename S>
+            const env_t& recv_t_<S>::tag_invoke(get_env_t) const noexcept
+            {
+                return state_->get_env();
+            }
+
+            // The consumer, takes ownership of one reference to the shared state
+            template <typename S, typename R, bool Move>
+            class ops_t_ final : public waiter_base
+            {
+            public:
+                // clang-format off
+                template <typename R2>
+                ops_t_(shared_state<S>* state, R2&& recv) noexcept(std::is_nothrow_constructible_v<R, R2>):
+                    state_(state), recv_(static_cast<R2&&>(recv)) {}
+                // clang-format on
+
+                ~ops_t_() noexcept { state_->release(); }
+
+                void tag_invoke(start_t) noexcept
+                {
+                    if constexpr (Move) // We are the only consumer, forward stop requests to the child
+                        callback_.emplace(get_stop_token(get_env(recv_)), stop_callback{state_});
+                    if (state_->add_waiter(*this))
+                        state_->start();
+                    else // Late subscribers complete inline
+                        notify();
+                }
+
+                void notify() noexcept override
+                {
+                    if constexpr (Move)
+                        callback_.reset();
+                    std::visit(
+                        [&]<typename Tup>(Tup& result) noexcept
+                        {
+                            if constexpr (std::is_same_v<Tup, std::monostate>)
+                                unreachable();
+                            else
+                                std::apply(
+                                    [&]<typename Cpo, typename... Ts>(const Cpo, Ts&... args) noexcept
+                                    {
+                                        if constexpr (Move)
+                                            Cpo{}(static_cast<R&&>(recv_), std::move(args)...);
+                                        else if constexpr (std::is_same_v<Cpo, set_value_t>)
+                                            Cpo{}(static_cast<R&&>(recv_), std::as_const(args)...);
+                                        else
+                                            Cpo{}(static_cast<R&&>(recv_), Ts(args)...);
+                                    },
+                                    result);
+                        },
+                        state_->result());
+                }
+
+            private:
+                struct stop_callback
+                {
+                    shared_state<S>* state;
+                    void operator()() const noexcept { state->request_stop(); }
+                };
+                using callback_t = optional_stop_callback<stop_token_of_t<env_of_t<R>>, stop_callback>;
+
+                shared_state<S>* state_;
+                R recv_;
+                CLU_NO_UNIQUE_ADDRESS conditional_t<Move, callback_t, std::monostate> callback_;
+            };
+
+            template <typename S, typename R, bool Move>
+            using ops_t = ops_t_<S, std::remove_cvref_t<R>, Move>;
+
+            template <typename S>
+            class split_snd_t_
+            {
+            public:
+                using is_sender = void;
+
+                // clang-format off
+                template <typename S2>
+                    requires(!std::same_as<std::remove_cvref_t<S2>, split_snd_t_>)
+                explicit split_snd_t_(S2&& snd):
+                    state_(new shared_state<S>(static_cast<S2&&>(snd))) {}
+                // clang-format on
+
+                split_snd_t_(const split_snd_t_& other) noexcept: state_(other.state_) { state_->add_ref(); }
+                split_snd_t_(split_snd_t_&& other) noexcept: state_(std::exchange(other.state_, nullptr)) {}
+                split_snd_t_& operator=(split_snd_t_ other) noexcept
+                {
+                    std::swap(state_, other.state_);
+                    return *this;
+                }
+                ~split_snd_t_() noexcept
+                {
+                    if (state_)
+                        state_->release();
+                }
+
+                template <receiver R>
+                auto tag_invoke(connect_t, R&& recv) const
+                {
+                    state_->add_ref();
+                    scope_fail guard([&]() noexcept { state_->release(); }); // The receiver may throw on copy
+                    return ops_t<S, R, false>(state_, static_cast<R&&>(recv));
+                }
+
+                template <typename Env>
+                constexpr static sigs_t<S, false> tag_invoke(get_completion_signatures_t, Env&&) noexcept
+                {
+                    return {};
+                }
+
+            private:
+                shared_state<S>* state_;
+            };
+
+            template <typename S>
+            class ensure_started_snd_t_
+            {
+            public:
+                using is_sender = void;
+
+                template <typename S2>
+                    requires(!std::same_as<std::remove_cvref_t<S2>, ensure_started_snd_t_>)
+                explicit ensure_started_snd_t_(S2&& snd): state_(new shared_state<S>(static_cast<S2&&>(snd)))
+                {
+                    state_->start();
+                }
+
+                ensure_started_snd_t_(ensure_started_snd_t_&& other) noexcept:
+                    state_(std::exchange(other.state_, nullptr)) {}
+                ensure_started_snd_t_& operator=(ensure_started_snd_t_&&) = delete;
+                ~ensure_started_snd_t_() noexcept
+                {
+                    if (state_) // Detached without being connected, the result is not needed anymore
+                    {
+                        state_->request_stop();
+                        state_->release();
+                    }
+                }
+
+                template <receiver R>
+                auto tag_invoke(connect_t, R&& recv) &&
+                {
+                    // Keep the ownership if constructing the receiver throws
+                    scope_success guard([&]() noexcept { state_ = nullptr; });
+                    return ops_t<S, R, true>(state_, static_cast<R&&>(recv));
+                }
+
+                template <typename Env>
+                constexpr static sigs_t<S, true> tag_invoke(get_completion_signatures_t, Env&&) noexcept
+                {
+                    return {};
+                }
+
+            private:
+                shared_state<S>* state_;
+            };
+
+            template <typename S>
+            using split_snd_t = split_snd_t_<std::decay_t<S>>;
+            template <typename S>
+            using ensure_started_snd_t = ensure_started_snd_t_<std::decay_t<S>>;
+
+            struct split_t
+            {
+                template <sender_in<env_t> S>
+                CLU_STATIC_CALL_OPERATOR(auto)
+                (S&& snd)
+                {
+                    if constexpr (tag_invocable<split_t, S>)
+                    {
+                        static_assert(sender<tag_invoke_result_t<split_t, S>>,
+                            "customization of split should return a sender");
+                        return clu::tag_invoke(split_t{}, static_cast<S&&>(snd));
+                    }
+                    else
+                        return split_snd_t<S>(static_cast<S&&>(snd));
+                }
+                constexpr CLU_STATIC_CALL_OPERATOR(auto)() noexcept { return make_piper(split_t{}); }
+            };
+
+            struct ensure_started_t
+            {
+                template <sender_in<env_t> S>
+                CLU_STATIC_CALL_OPERATOR(auto)
+                (S&& snd)
+                {
+                    if constexpr (tag_invocable<ensure_started_t, S>)
+                    {
+                        static_assert(sender<tag_invoke_result_t<ensure_started_t, S>>,
+                            "customization of ensure_started should return a sender");
+                        return clu::tag_invoke(ensure_started_t{}, static_cast<S&&>(snd));
+                    }
+                    else
+                        return ensure_started_snd_t<S>(static_cast<S&&>(snd));
+                }
+                constexpr CLU_STATIC_CALL_OPERATOR(auto)() noexcept { return make_piper(ensure_started_t{}); }
+            };
         } // namespace split
     } // namespace detail
 
     using detail::when_all::when_all_t;
+    using detail::when_all_rng::when_all_range_t;
     using detail::when_any::when_any_t;
     using detail::stop_when::stop_when_t;
     using detail::dtch_cncl::detach_on_stop_request_t;
+    using detail::split::split_t;
+    using detail::split::ensure_started_t;
 
     inline constexpr when_all_t when_all{};
+    inline constexpr when_all_range_t when_all_range{};
     inline constexpr when_any_t when_any{};
     inline constexpr stop_when_t stop_when{};
     inline constexpr detach_on_stop_request_t detach_on_stop_request{};
+    inline constexpr split_t split{};
+    inline constexpr ensure_started_t ensure_started{};
 
     using detail::dtch_cncl::noop_cleanup_factory_t;
     using detail::dtch_cncl::noop_cleanup_factory;
@@ -362,12 +362,212 @@ namespace clu::exec
             };
         } // namespace schd_from
 
+        namespace yld
+        {
+            template <typename Env>
+            using schd_of_t = call_result_t<get_scheduler_t, Env>;
+
+            // Yielding only makes sense if we know where to yield to, and when to do so
+            template <typename Env>
+            concept time_sliced_env = requires(const Env& env) { exec::get_time_slice(exec::get_scheduler(env)); };
+
+            template <typename S, typename R>
+            class ops_t_;
+            template <typename S, typename R>
+            using ops_t = ops_t_<S, std::remove_cvref_t<R>>;
+
+            template <typename S, typename R>
+            class recv_t : public receiver_adaptor<recv_t<S, R>>
+            {
+            public:
+                using is_receiver = void;
+
+                explicit recv_t(ops_t<S, R>* ops) noexcept: ops_(ops) {}
+
+                const R& base() const& noexcept;
+                R&& base() && noexcept;
+
+                template <typename... Args>
+                void set_value(Args&&... args) && noexcept;
+
+            private:
+                ops_t<S, R>* ops_;
+            };
+
+            template <typename S, typename R>
+            class recv2_t : public receiver_adaptor<recv2_t<S, R>>
+            {
+            public:
+                using is_receiver = void;
+
+                explicit recv2_t(ops_t<S, R>* ops) noexcept: ops_(ops) {}
+
+                const R& base() const& noexcept;
+                R&& base() && noexcept;
+                void set_value() && noexcept;
+
+            private:
+                ops_t<S, R>* ops_;
+            };
+
+            template <typename S, typename R>
+            class ops_t_
+            {
+            public:
+                // clang-format off
+                template <typename R2>
+                ops_t_(S&& snd, R2&& recv, const std::chrono::nanoseconds budget):
+                    recv_(static_cast<R2&&>(recv)), budget_(budget),
+                    initial_ops_(exec::connect(static_cast<S&&>(snd), recv_t<S, R>(this))) {}
+                // clang-format on
+
+                void tag_invoke(start_t) noexcept { exec::start(initial_ops_); }
+
+            private:
+                friend recv_t<S, R>;
+                friend recv2_t<S, R>;
+
+                using env_type = env_of_t<R>;
+                using schd_type = schd_of_t<env_type>;
+                using yield_ops_t = connect_result_t<schedule_result_t<schd_type>, recv2_t<S, R>>;
+
+                R recv_;
+                std::chrono::nanoseconds budget_;
+                connect_result_t<S, recv_t<S, R>> initial_ops_;
+                value_types_of_t<S, env_type, decayed_tuple, nullable_variant> values_;
+                ops_optional<yield_ops_t> yield_ops_;
+
+                bool expired() const noexcept
+                {
+                    const auto slice_start = exec::get_time_slice(exec::get_scheduler(get_env(recv_)));
+                    using clock = typename decltype(slice_start)::clock;
+                    return clock::now() - slice_start >= budget_;
+                }
+            };
+
+            // clang-format off
+            template <typename S, typename R>
+            const R& recv_t<S, R>::base() const & noexcept { return ops_->recv_; }
+            template <typename S, typename R>
+            R&& recv_t<S, R>::base() && noexcept { return static_cast<R&&>(ops_->recv_); }
+            template <typename S, typename R>
+            const R& recv2_t<S, R>::base() const & noexcept { return ops_->recv_; }
+            template <typename S, typename R>
+            R&& recv2_t<S, R>::base() && noexcept { return static_cast<R&&>(ops_->recv_); }
+            // clang-format on
+
+            template <typename S, typename R>
+            template <typename... Args>
+            void recv_t<S, R>::set_value(Args&&... args) && noexcept
+            {
+                auto* ops = ops_; // *this may be destroyed
+                if (!ops->expired()) // Still within budget, just continue inline
+                {
+                    exec::set_value(static_cast<R&&>(ops->recv_), static_cast<Args&&>(args)...);
+                    return;
+                }
+                try
+                {
+                    // Store the values and reschedule to the back of the queue
+                    ops->values_.template emplace<decayed_tuple<Args...>>(static_cast<Args&&>(args)...);
+                    exec::start(ops->yield_ops_.emplace_with(
+                        [&]
+                        {
+                            return exec::connect(exec::schedule(exec::get_scheduler(get_env(ops->recv_))),
+                                recv2_t<S, R>(ops));
+                        }));
+                }
+                catch (...)
+                {
+                    exec::set_error(static_cast<R&&>(ops->recv_), std::current_exception());
+                }
+            }
+
+            template <typename S, typename R>
+            void recv2_t<S, R>::set_value() && noexcept
+            {
+                // clang-format off
+                std::visit(
+                    [&]<typename Tup>(Tup&& tuple) noexcept
+                    {
+                        if constexpr (std::is_same_v<Tup, std::monostate>)
+                            unreachable();
+                        else
+                            std::apply(
+                                [&]<typename... Args>(Args&&... args) noexcept
+                                {
+                                    exec::set_value(static_cast<R&&>(ops_->recv_), static_cast<Args&&>(args)...);
+                                }, static_cast<Tup&&>(tuple));
+                    }, std::move(ops_->values_));
+                // clang-format on
+            }
+
+            template <typename S>
+            class snd_t_
+            {
+            public:
+                using is_sender = void;
+
+                // clang-format off
+                template <typename S2>
+                snd_t_(S2&& snd, const std::chrono::nanoseconds budget):
+                    snd_(static_cast<S2&&>(snd)), budget_(budget) {}
+                // clang-format on
+
+                template <receiver R>
+                auto tag_invoke(connect_t, R&& recv) &&
+                {
+                    if constexpr (time_sliced_env<env_of_t<R>>)
+                        return ops_t<S, R>(static_cast<S&&>(snd_), static_cast<R&&>(recv), budget_);
+                    else // No way of knowing how long we have been running, just pass through
+                        return exec::connect(static_cast<S&&>(snd_), static_cast<R&&>(recv));
+                }
+
+                CLU_EXEC_FWD_ENV(snd_);
+
+                template <typename Env>
+                constexpr static auto tag_invoke(get_completion_signatures_t, Env&&) noexcept
+                {
+                    if constexpr (time_sliced_env<Env>)
+                        return make_completion_signatures<S, Env,
+                            schd_from::additional_sigs<schd_of_t<Env>, Env>>{};
+                    else
+                        return completion_signatures_of_t<S, Env>{};
+                }
+
+            private:
+                S snd_;
+                std::chrono::nanoseconds budget_;
+            };
+
+            template <typename S>
+            using snd_t = snd_t_<std::remove_cvref_t<S>>;
+
+            struct yield_if_expired_t
+            {
+                template <sender S>
+                CLU_STATIC_CALL_OPERATOR(auto)
+                (S&& snd, const duration auto budget)
+                {
+                    return snd_t<S>(static_cast<S&&>(snd), //
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(budget));
+                }
+
+                CLU_STATIC_CALL_OPERATOR(auto)(const duration auto budget)
+                {
+                    return clu::make_piper(clu::bind_back(yield_if_expired_t{}, budget));
+                }
+            };
+        } // namespace yld
+
 #undef CLU_EXEC_FWD_ENV
     } // namespace detail
 
     using detail::on::on_t;
     using detail::schd_from::schedule_from_t;
+    using detail::yld::yield_if_expired_t;
 
     inline constexpr on_t on{};
     inline constexpr schedule_from_t schedule_from{};
+    inline constexpr yield_if_expired_t yield_if_expired{};
 } // namespace clu::exec
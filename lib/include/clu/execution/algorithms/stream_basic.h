@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
+#include <mutex>
+
 #include "basic.h"
+#include "parallel.h"
 
 namespace clu::exec
 {
@@ -643,10 +647,556 @@ namespace clu::exec
             };
         } // namespace fltr
 
-        // TODO: merge: stream<T>... -> stream<T>
+        template <typename... Ss>
+        auto cleanup_all(std::tuple<Ss...>& streams)
+        {
+            return std::apply([](Ss&... strms) { return exec::when_all(cleanup(strms)...); }, streams);
+        }
+
+        namespace mrg
+        {
+            using env_t = adapted_env_t<empty_env, query_value<get_stop_token_t, in_place_stop_token>>;
+
+            template <typename... Ts>
+            using value_result = decayed_tuple<set_value_t, Ts...>;
+            template <typename... Es>
+            using error_results = type_list<decayed_tuple<set_error_t, Es>...>;
+            using exception_result = std::tuple<set_error_t, std::exception_ptr>;
+
+            // Every possible non-stopped completion of the next sender of a stream, stored as (cpo, args...)
+            template <typename S>
+            using results_of = meta::concatenate_l< //
+                value_types_of_t<next_result_t<S>, env_t, value_result, type_list>,
+                error_types_of_t<next_result_t<S>, env_t, error_results>>;
+
+            template <typename... Ss>
+            using results_t = meta::unique_l<meta::flatten<results_of<Ss>..., type_list<exception_result>>>;
+
+            template <typename... Ss>
+            using result_t = meta::unpack_invoke<results_t<Ss...>, meta::quote<nullable_variant>>;
+
+            template <typename Tup>
+            struct result_sig;
+            template <typename Cpo, typename... Ts>
+            struct result_sig<std::tuple<Cpo, Ts...>>
+            {
+                using type = Cpo(Ts...);
+            };
+
+            template <typename... Tups>
+            using sigs_of_results = completion_signatures<typename result_sig<Tups>::type..., set_stopped_t()>;
+
+            template <typename Res>
+            class waiter_base
+            {
+            public:
+                waiter_base() noexcept = default;
+                CLU_IMMOVABLE_TYPE(waiter_base);
+                virtual void set(Res&& result) noexcept = 0;
+                virtual void set_stopped() noexcept = 0;
+
+            protected:
+                ~waiter_base() noexcept = default;
+            };
+
+            class drain_base
+            {
+            public:
+                drain_base() noexcept = default;
+                CLU_IMMOVABLE_TYPE(drain_base);
+                virtual void drained() noexcept = 0;
+
+            protected:
+                ~drain_base() noexcept = default;
+            };
+
+            template <typename... Ss>
+            struct stream_t_
+            {
+                class type;
+            };
+
+            template <typename... Ss>
+            using stream_t = typename stream_t_<std::decay_t<Ss>...>::type;
+
+            template <std::size_t I, typename... Ss>
+            struct child_recv_t_
+            {
+                class type;
+            };
+
+            template <std::size_t I, typename... Ss>
+            using child_recv_t = typename child_recv_t_<I, Ss...>::type;
+
+            template <std::size_t I, typename... Ss>
+            class child_recv_t_<I, Ss...>::type
+            {
+            public:
+                using is_receiver = void;
+
+                explicit type(stream_t<Ss...>* strm) noexcept: strm_(strm) {}
+
+            private:
+                stream_t<Ss...>* strm_;
+
+                template <completion_cpo Cpo, typename... Ts>
+                friend void tag_invoke(Cpo, type&& self, Ts&&... args) noexcept
+                {
+                    self.strm_->template child_done<I>(Cpo{}, static_cast<Ts&&>(args)...);
+                }
+
+                friend env_t tag_invoke(get_env_t, const type& self) noexcept { return self.strm_->get_child_env(); }
+            };
+
+            template <typename R, typename... Ss>
+            struct next_ops_t_
+            {
+                class type;
+            };
+
+            template <typename R, typename... Ss>
+            using next_ops_t = typename next_ops_t_<std::decay_t<R>, Ss...>::type;
+
+            template <typename R, typename... Ss>
+            class next_ops_t_<R, Ss...>::type final : public waiter_base<result_t<Ss...>>
+            {
+            public:
+                // clang-format off
+                template <typename R2>
+                type(stream_t<Ss...>* strm, R2&& recv):
+                    strm_(strm), recv_(static_cast<R2&&>(recv)) {}
+                // clang-format on
+
+                void set(result_t<Ss...>&& result) noexcept override
+                {
+                    callback_.reset();
+                    std::visit(
+                        [&]<typename Tup>(Tup&& tup) noexcept
+                        {
+                            if constexpr (std::is_same_v<Tup, std::monostate>)
+                                unreachable();
+                            else
+                                std::apply([&]<typename Cpo, typename... Ts>(Cpo, Ts&&... args) noexcept
+                                    { Cpo{}(static_cast<R&&>(recv_), static_cast<Ts&&>(args)...); },
+                                    static_cast<Tup&&>(tup));
+                        },
+                        std::move(result));
+                }
+
+                void set_stopped() noexcept override
+                {
+                    callback_.reset();
+                    exec::set_stopped(static_cast<R&&>(recv_));
+                }
+
+            private:
+                struct stop_callback
+                {
+                    type* self;
+
+                    void operator()() const noexcept
+                    {
+                        // Only complete the receiver if no child stream has claimed this operation yet
+                        if (self->strm_->remove_waiter(*self))
+                            exec::set_stopped(static_cast<R&&>(self->recv_));
+                    }
+                };
+
+                stream_t<Ss...>* strm_;
+                CLU_NO_UNIQUE_ADDRESS R recv_;
+                CLU_NO_UNIQUE_ADDRESS optional_stop_callback<stop_token_of_t<env_of_t<R>>, stop_callback> callback_;
+
+                friend void tag_invoke(start_t, type& self) noexcept
+                {
+                    const auto token = get_stop_token(clu::get_env(self.recv_));
+                    self.callback_.emplace(token, stop_callback{&self});
+                    self.strm_->start_waiter(self, token);
+                }
+            };
+
+            template <typename... Ss>
+            struct next_snd_t_
+            {
+                class type;
+            };
+
+            template <typename... Ss>
+            using next_snd_t = typename next_snd_t_<Ss...>::type;
+
+            template <typename... Ss>
+            class next_snd_t_<Ss...>::type
+            {
+            public:
+                using is_sender = void;
+
+                explicit type(stream_t<Ss...>* strm) noexcept: strm_(strm) {}
+
+            private:
+                stream_t<Ss...>* strm_;
+
+                // clang-format off
+                friend meta::unpack_invoke<results_t<Ss...>, meta::quote<sigs_of_results>> tag_invoke(
+                    get_completion_signatures_t, const type&, auto&&) noexcept { return {}; }
+                // clang-format on
+
+                template <typename R>
+                friend auto tag_invoke(connect_t, const type self, R&& recv)
+                {
+                    return next_ops_t<R, Ss...>(self.strm_, static_cast<R&&>(recv));
+                }
+            };
+
+            template <typename R, typename... Ss>
+            struct drain_ops_t_
+            {
+                class type;
+            };
+
+            template <typename R, typename... Ss>
+            using drain_ops_t = typename drain_ops_t_<std::decay_t<R>, Ss...>::type;
+
+            template <typename R, typename... Ss>
+            class drain_ops_t_<R, Ss...>::type final : public drain_base
+            {
+            public:
+                // clang-format off
+                template <typename R2>
+                type(stream_t<Ss...>* strm, R2&& recv):
+                    strm_(strm), recv_(static_cast<R2&&>(recv)) {}
+                // clang-format on
+
+                void drained() noexcept override { exec::set_value(static_cast<R&&>(recv_)); }
+
+            private:
+                stream_t<Ss...>* strm_;
+                CLU_NO_UNIQUE_ADDRESS R recv_;
+
+                friend void tag_invoke(start_t, type& self) noexcept { self.strm_->start_drain(self); }
+            };
+
+            // Completes after every in-flight next operation of the child streams has finished
+            template <typename... Ss>
+            struct drain_snd_t_
+            {
+                class type;
+            };
+
+            template <typename... Ss>
+            using drain_snd_t = typename drain_snd_t_<Ss...>::type;
+
+            template <typename... Ss>
+            class drain_snd_t_<Ss...>::type
+            {
+            public:
+                using is_sender = void;
+
+                explicit type(stream_t<Ss...>* strm) noexcept: strm_(strm) {}
+
+            private:
+                stream_t<Ss...>* strm_;
+
+                // clang-format off
+                friend completion_signatures<set_value_t()> tag_invoke(
+                    get_completion_signatures_t, const type&, auto&&) noexcept { return {}; }
+                // clang-format on
+
+                template <typename R>
+                friend auto tag_invoke(connect_t, const type self, R&& recv)
+                {
+                    return drain_ops_t<R, Ss...>(self.strm_, static_cast<R&&>(recv));
+                }
+            };
+
+            template <typename... Ss>
+            class stream_t_<Ss...>::type
+            {
+            private:
+                using result_type = result_t<Ss...>;
+                using waiter_type = waiter_base<result_type>;
+
+            public:
+                // clang-format off
+                template <typename... Ss2>
+                    requires(sizeof...(Ss2) == sizeof...(Ss)) && (!std::same_as<std::remove_cvref_t<Ss2>, type> && ...)
+                explicit type(Ss2&&... streams):
+                    streams_(static_cast<Ss2&&>(streams)...) {}
+
+                // Only the child streams are transferred, the merging state should be idle
+                type(const type& other) requires(std::copy_constructible<Ss> && ...):
+                    streams_(other.streams_) {}
+                type(type&& other) noexcept((std::is_nothrow_move_constructible_v<Ss> && ...)):
+                    streams_(std::move(other.streams_)) {}
+                // clang-format on
+
+                env_t get_child_env() noexcept
+                {
+                    return clu::adapt_env(empty_env{}, query_value{get_stop_token, stop_src_.get_token()});
+                }
+
+                template <std::size_t I, completion_cpo Cpo, typename... Ts>
+                void child_done(Cpo, Ts&&... args) noexcept
+                {
+                    result_type result;
+                    bool ended = !std::is_same_v<Cpo, set_value_t>; // An error also ends the child stream
+                    if constexpr (!std::is_same_v<Cpo, set_stopped_t>)
+                    {
+                        // Save the result before the child operation gets destroyed
+                        try
+                        {
+                            result.template emplace<decayed_tuple<Cpo, Ts...>>(Cpo{}, static_cast<Ts&&>(args)...);
+                        }
+                        catch (...)
+                        {
+                            result.template emplace<exception_result>(set_error, std::current_exception());
+                            ended = true;
+                        }
+                    }
+
+                    std::unique_lock lock(mtx_);
+                    --running_;
+                    if (ended)
+                    {
+                        ended_[I] = true;
+                        --active_;
+                    }
+                    if (stop_src_.stop_requested()) // Cleaning up, drop the result
+                    {
+                        if (running_ == 0 && drain_)
+                        {
+                            auto* drain = std::exchange(drain_, nullptr);
+                            lock.unlock();
+                            finish_drain(*drain);
+                        }
+                        return;
+                    }
+                    if (result.index() == 0) // The child stream has ended
+                    {
+                        // A waiter is only registered when there's no buffered result,
+                        // so if every child has ended the merged stream also ends here
+                        if (active_ == 0 && waiter_)
+                        {
+                            auto* waiter = std::exchange(waiter_, nullptr);
+                            lock.unlock();
+                            waiter->set_stopped();
+                        }
+                        return;
+                    }
+                    if (!waiter_) // No one is waiting, buffer the result in the slot of this child
+                    {
+                        results_[I] = std::move(result);
+                        return;
+                    }
+                    auto* waiter = std::exchange(waiter_, nullptr);
+                    if (!ended)
+                        ++running_;
+                    lock.unlock();
+                    if (!ended)
+                        start_child<I>(); // Pull the next element eagerly
+                    waiter->set(std::move(result));
+                }
+
+                template <typename Token>
+                void start_waiter(waiter_type& waiter, const Token& token) noexcept
+                {
+                    std::unique_lock lock(mtx_);
+                    if (token.stop_requested())
+                    {
+                        lock.unlock();
+                        waiter.set_stopped();
+                        return;
+                    }
+                    if (!started_) // Start pulling from every child stream on the first next()
+                    {
+                        started_ = true;
+                        running_ = sizeof...(Ss);
+                        waiter_ = &waiter;
+                        lock.unlock();
+                        start_all(std::index_sequence_for<Ss...>{});
+                        return;
+                    }
+                    for (std::size_t i = 0; i < sizeof...(Ss); i++)
+                    {
+                        // Round robin so that no child stream can starve the others
+                        const std::size_t idx = (cursor_ + i) % sizeof...(Ss);
+                        if (results_[idx].index() == 0)
+                            continue;
+                        result_type result = std::move(results_[idx]);
+                        results_[idx].template emplace<0>();
+                        cursor_ = idx + 1;
+                        const bool restart = !ended_[idx];
+                        if (restart)
+                            ++running_;
+                        lock.unlock();
+                        if (restart)
+                            start_child_at(idx);
+                        waiter.set(std::move(result));
+                        return;
+                    }
+                    if (active_ == 0) // Every child stream has ended
+                    {
+                        lock.unlock();
+                        waiter.set_stopped();
+                        return;
+                    }
+                    waiter_ = &waiter;
+                }
+
+                bool remove_waiter(waiter_type& waiter) noexcept
+                {
+                    std::unique_lock lock(mtx_);
+                    if (waiter_ != &waiter)
+                        return false;
+                    waiter_ = nullptr;
+                    return true;
+                }
+
+                void start_drain(drain_base& drain) noexcept
+                {
+                    stop_src_.request_stop(); // Cancel the in-flight next operations
+                    std::unique_lock lock(mtx_);
+                    if (running_ != 0)
+                    {
+                        drain_ = &drain;
+                        return;
+                    }
+                    lock.unlock();
+                    finish_drain(drain);
+                }
+
+            private:
+                template <std::size_t I>
+                using child_stream_t = typename meta::nth_type_q<I>::template fn<Ss...>;
+                template <std::size_t I>
+                using child_ops_t = connect_result_t<next_result_t<child_stream_t<I>>, child_recv_t<I, Ss...>>;
+
+                template <std::size_t... Is>
+                static auto children_ops_impl(std::index_sequence<Is...>) //
+                    -> std::tuple<ops_optional<child_ops_t<Is>>...>;
+                using children_ops_t = decltype(type::children_ops_impl(std::index_sequence_for<Ss...>{}));
+
+                std::tuple<Ss...> streams_;
+                std::mutex mtx_;
+                in_place_stop_source stop_src_;
+                children_ops_t children_;
+                std::array<result_type, sizeof...(Ss)> results_{};
+                std::array<bool, sizeof...(Ss)> ended_{};
+                std::size_t active_ = sizeof...(Ss); // Number of child streams that have not ended
+                std::size_t running_ = 0; // Number of in-flight next operations of the child streams
+                std::size_t cursor_ = 0;
+                bool started_ = false;
+                waiter_type* waiter_ = nullptr;
+                drain_base* drain_ = nullptr;
+
+                template <std::size_t I>
+                void start_child() noexcept
+                {
+                    auto& ops = std::get<I>(children_);
+                    ops.reset();
+                    try
+                    {
+                        start(ops.emplace_with([&]
+                            { return connect(next(std::get<I>(streams_)), child_recv_t<I, Ss...>(this)); }));
+                    }
+                    catch (...)
+                    {
+                        ops.reset();
+                        child_done<I>(set_error, std::current_exception());
+                    }
+                }
+
+                void start_child_at(const std::size_t idx) noexcept
+                {
+                    [&]<std::size_t... Is>(std::index_sequence<Is...>)
+                    {
+                        (void)((Is == idx ? (start_child<Is>(), true) : false) || ...); //
+                    }(std::index_sequence_for<Ss...>{});
+                }
+
+                template <std::size_t... Is>
+                void start_all(std::index_sequence<Is...>) noexcept
+                {
+                    (start_child<Is>(), ...);
+                }
+
+                void finish_drain(drain_base& drain) noexcept
+                {
+                    // Every child operation has completed by now
+                    std::apply([](auto&... ops) { (ops.reset(), ...); }, children_);
+                    for (auto& result : results_)
+                        result.template emplace<0>();
+                    drain.drained();
+                }
+
+                friend auto tag_invoke(next_t, type& self) noexcept { return next_snd_t<Ss...>(&self); }
+
+                friend auto tag_invoke(cleanup_t, type& self) noexcept
+                {
+                    // Wait for the in-flight next operations to finish before cleaning up the child streams
+                    return drain_snd_t<Ss...>(&self) | let_value([&self] { return cleanup_all(self.streams_); });
+                }
+            };
+
+            struct merge_t
+            {
+                template <stream... Ss>
+                    requires(sizeof...(Ss) > 0)
+                CLU_STATIC_CALL_OPERATOR(auto)
+                (Ss&&... strms)
+                {
+                    return stream_t<Ss...>(static_cast<Ss&&>(strms)...);
+                }
+            };
+        } // namespace mrg
+
         // TODO: join: stream<T>... -> stream<T>
         // TODO: debounce: stream<T>, time_scheduler, duration -> stream<T>
-        // TODO: zip: stream<Ts>... -> stream<Ts...>
+
+        namespace zp
+        {
+            template <typename... Ss>
+            struct stream_t_
+            {
+                class type;
+            };
+
+            template <typename... Ss>
+            using stream_t = typename stream_t_<std::decay_t<Ss>...>::type;
+
+            template <typename... Ss>
+            class stream_t_<Ss...>::type
+            {
+            public:
+                // clang-format off
+                template <typename... Ss2>
+                    requires(sizeof...(Ss2) == sizeof...(Ss)) && (!std::same_as<std::remove_cvref_t<Ss2>, type> && ...)
+                explicit type(Ss2&&... streams):
+                    streams_(static_cast<Ss2&&>(streams)...) {}
+                // clang-format on
+
+            private:
+                std::tuple<Ss...> streams_;
+
+                // Pulls from every child stream in lock-step, the zipped stream ends as soon as any child ends
+                friend auto tag_invoke(next_t, type& self)
+                {
+                    return std::apply([](Ss&... streams) { return exec::when_all(next(streams)...); }, self.streams_);
+                }
+
+                friend auto tag_invoke(cleanup_t, type& self) noexcept { return cleanup_all(self.streams_); }
+            };
+
+            struct zip_t
+            {
+                template <stream... Ss>
+                    requires(sizeof...(Ss) > 0)
+                CLU_STATIC_CALL_OPERATOR(auto)
+                (Ss&&... strms)
+                {
+                    return stream_t<Ss...>(static_cast<Ss&&>(strms)...);
+                }
+            };
+        } // namespace zp
+
         // TODO: combine: stream<Ts>... -> stream<Ts...>
         // TODO: flatten: stream<stream<T>>, int? max_concurrency -> stream<T>
 
@@ -914,11 +1464,15 @@ namespace clu::exec
     using detail::adpt_cln::adapt_cleanup_t;
     using detail::rdc::reduce_t;
     using detail::fltr::filter_t;
+    using detail::mrg::merge_t;
+    using detail::zp::zip_t;
     using detail::vec::into_vector_t;
 
     inline constexpr adapt_next_t adapt_next{};
     inline constexpr adapt_cleanup_t adapt_cleanup{};
     inline constexpr reduce_t reduce{};
     inline constexpr filter_t filter{};
+    inline constexpr merge_t merge{};
+    inline constexpr zip_t zip{};
     inline constexpr into_vector_t into_vector{};
 } // namespace clu::exec
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <utility>
+#include <system_error>
 #include "execution_traits.h"
 
 namespace clu::exec
@@ -36,6 +37,7 @@ namespace clu::exec
         {
             void (*set_value)(void*) noexcept = nullptr;
             void (*set_error)(void*, const std::exception_ptr&) noexcept = nullptr;
+            void (*set_error_code)(void*, std::error_code) noexcept = nullptr; // Typed slot, no allocation
             void (*set_stopped)(void*) noexcept = nullptr;
         };
 
@@ -50,6 +52,8 @@ namespace clu::exec
             .set_value = [](void* ptr) noexcept { exec::set_value(as_rvalue<R>(ptr)); },
             .set_error = [](void* ptr, const std::exception_ptr& eptr) noexcept
             { exec::set_error(as_rvalue<R>(ptr), eptr); },
+            .set_error_code = [](void* ptr, const std::error_code ec) noexcept
+            { exec::set_error(as_rvalue<R>(ptr), ec); },
             .set_stopped = [](void* ptr) noexcept { exec::set_stopped(as_rvalue<R>(ptr)); } //
         };
 
@@ -82,7 +86,10 @@ namespace clu::exec
             template <typename E>
             friend void tag_invoke(set_error_t, proxy_recv_t&& self, E&& error) noexcept
             {
-                self.vfptr_->set_error(self.ptr_, detail::make_exception_ptr(static_cast<E&&>(error)));
+                if constexpr (decays_to<E, std::error_code>)
+                    self.vfptr_->set_error_code(self.ptr_, error);
+                else
+                    self.vfptr_->set_error(self.ptr_, detail::make_exception_ptr(static_cast<E&&>(error)));
             }
             friend void tag_invoke(set_stopped_t, proxy_recv_t&& self) noexcept { self.vfptr_->set_stopped(self.ptr_); }
             friend env_t tag_invoke(get_env_t, const proxy_recv_t& self) noexcept { return {self.token_}; }
@@ -260,7 +267,8 @@ namespace clu::exec
             }
 
             // clang-format off
-            friend completion_signatures<set_value_t(), set_error_t(std::exception_ptr), set_stopped_t()>
+            friend completion_signatures<set_value_t(), set_error_t(std::exception_ptr),
+                set_error_t(std::error_code), set_stopped_t()>
             tag_invoke(get_completion_signatures_t, const snd_t&, auto&&) noexcept { return {}; }
             // clang-format on
 
@@ -1164,6 +1164,27 @@ namespace clu::exec
     using detail::get_forward_progress_guarantee_t;
     inline constexpr get_forward_progress_guarantee_t get_forward_progress_guarantee{};
 
+    namespace detail
+    {
+        // Queries the time point at which the current time slice of the calling execution agent started,
+        // only meaningful when called from work executing on the queried scheduler
+        struct get_time_slice_t
+        {
+            template <scheduler S>
+                requires tag_invocable<get_time_slice_t, const S&>
+            CLU_STATIC_CALL_OPERATOR(auto)(const S& schd) noexcept
+            {
+                static_assert(nothrow_tag_invocable<get_time_slice_t, const S&>, "get_time_slice should be noexcept");
+                static_assert(time_point<tag_invoke_result_t<get_time_slice_t, const S&>>,
+                    "return type of get_time_slice should satisfy time_point");
+                return clu::tag_invoke(get_time_slice_t{}, schd);
+            }
+        };
+    } // namespace detail
+
+    using detail::get_time_slice_t;
+    inline constexpr get_time_slice_t get_time_slice{};
+
     namespace detail
     {
         struct next_t
@@ -154,6 +154,13 @@ namespace clu::exec
                     CLU_SINGLE_RETURN(lhs.state_ == rhs.state_);
                 friend auto tag_invoke(schedule_t, const type& self) //
                     CLU_SINGLE_RETURN(snd_t<SchdSt, OpsSt, Callback>(self.state_, self.callback_));
+
+                // Forward the time slice query to the scheduler state if it supports it
+                friend auto tag_invoke(get_time_slice_t, const type& self) noexcept
+                    requires tag_invocable<get_time_slice_t, const SchdSt&>
+                {
+                    return clu::tag_invoke(get_time_slice_t{}, self.state_);
+                }
             };
 
 #undef CLU_CREATE_SCHD_MEMBERS
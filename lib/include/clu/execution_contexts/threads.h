@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <thread>
 
@@ -35,6 +36,14 @@ namespace clu
 
     namespace detail::static_tp
     {
+        using clock = std::chrono::steady_clock;
+
+        class pool;
+
+        // Start of the time slice of the current task if this thread is a worker of the pool,
+        // otherwise the slice is considered to start right now
+        clock::time_point current_slice_start(const pool* ctx) noexcept;
+
         class pool
         {
         public:
@@ -52,6 +61,12 @@ namespace clu
             {
                 pool* ctx;
                 friend bool operator==(schd_state, schd_state) noexcept = default;
+
+                // Every task dequeued by a worker starts a new time slice on that worker
+                friend clock::time_point tag_invoke(exec::get_time_slice_t, schd_state self) noexcept
+                {
+                    return static_tp::current_slice_start(self.ctx);
+                }
             };
             struct ops_state;
             using ops_base = exec::scheduler_operation_base<ops_state, schd_state>;
@@ -2,6 +2,7 @@
 
 #include <thread>
 #include <optional>
+#include <system_error>
 #include <condition_variable>
 
 #include "timed_threads.h"
@@ -16,9 +17,28 @@ namespace clu
         using clock = std::chrono::steady_clock;
 
         template <typename Env>
-        using sigs = exec::detail::filtered_sigs<exec::set_value_t(), exec::set_error_t(std::exception_ptr),
+        using sigs = exec::detail::filtered_sigs<exec::set_value_t(), exec::set_error_t(std::error_code),
             conditional_t<exec::detail::stoppable_env<Env>, exec::set_stopped_t(), void>>;
 
+        // Starts a detached thread running func, reports failure to spawn the thread as an error code
+        // so that the error channel never needs an exception_ptr
+        template <typename R, typename F>
+        void spawn_thread(R& recv, F&& func) noexcept
+        {
+            try
+            {
+                std::thread(static_cast<F&&>(func)).detach();
+            }
+            catch (const std::system_error& error)
+            {
+                exec::set_error(static_cast<R&&>(recv), error.code());
+            }
+            catch (const std::bad_alloc&)
+            {
+                exec::set_error(static_cast<R&&>(recv), std::make_error_code(std::errc::not_enough_memory));
+            }
+        }
+
         // exec::schedule
 
         template <typename R>
@@ -33,10 +53,7 @@ namespace clu
 
             void tag_invoke(exec::start_t) noexcept
             {
-                // clang-format off
-                try { std::thread([&] { start(); }).detach(); }
-                catch (...) { exec::set_error(static_cast<R&&>(recv_), std::current_exception()); }
-                // clang-format on
+                new_thrd_ctx::spawn_thread(recv_, [&] { start(); });
             }
 
         private:
@@ -86,10 +103,7 @@ namespace clu
 
             void tag_invoke(exec::start_t) noexcept
             {
-                // clang-format off
-                try { std::thread([&] { start(); }).detach(); }
-                catch (...) { exec::set_error(static_cast<R&&>(recv_), std::current_exception()); }
-                // clang-format on
+                new_thrd_ctx::spawn_thread(recv_, [&] { start(); });
             }
 
         private:
@@ -118,7 +132,7 @@ namespace clu
                 callback_.emplace(token, stop_callback{*this});
                 if (token.stop_requested())
                     exec::set_stopped(static_cast<R&&>(recv_));
-                std::thread([this, token] { this->work(token); }).detach();
+                new_thrd_ctx::spawn_thread(recv_, [this, token] { this->work(token); });
             }
 
         private:
@@ -366,11 +380,10 @@ namespace clu
                 ops_recv_base* self;
                 void operator()() noexcept { stop_ops(*self->loop_, *self); }
             };
-            using stop_callback_t = typename stop_token_of_t<env_of_t<R>>::template callback_type<callback>;
 
             timer_loop* loop_;
             CLU_NO_UNIQUE_ADDRESS R recv_;
-            std::optional<stop_callback_t> cb_;
+            CLU_NO_UNIQUE_ADDRESS optional_stop_callback<stop_token_of_t<env_of_t<R>>, callback> cb_;
         };
 
         template <typename R>
@@ -56,7 +56,7 @@ namespace clu
         template <typename Err>
             requires std::constructible_from<E, Err> && (!std::same_as<std::remove_cvref_t<Err>, std::in_place_t>) &&
             (!std::same_as<std::remove_cvref_t<Err>, unexpected>)
-        constexpr explicit unexpected(Err&& error): value_(static_cast<Err&>(error))
+        constexpr explicit unexpected(Err&& error): value_(static_cast<Err&&>(error))
         {
         }
 
@@ -114,8 +114,8 @@ namespace clu
             std::ranges::swap(value_, other.value_);
         }
 
-        template <class E1, class E2>
-        [[nodiscard]] constexpr friend bool operator==(const unexpected<E1>& lhs, const unexpected<E2>& rhs)
+        template <class E2>
+        [[nodiscard]] constexpr friend bool operator==(const unexpected& lhs, const unexpected<E2>& rhs)
         {
             return lhs.value() == rhs.value();
         }
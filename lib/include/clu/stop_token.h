@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <thread>
 
 #include "concepts.h"
@@ -75,6 +76,39 @@ namespace clu
         [[nodiscard]] friend constexpr bool operator==(never_stop_token, never_stop_token) noexcept = default;
     };
 
+    /**
+     * \brief An optional stop callback registered on a stop token, for operations which register the callback
+     * later than they are constructed.
+     * \details For unstoppable tokens this is an empty type and emplacing does nothing, so that a receiver
+     * with a never_stop_token pays nothing for the stop propagation. Use it with CLU_NO_UNIQUE_ADDRESS.
+     */
+    template <stoppable_token Token, typename Callback>
+    class optional_stop_callback
+    {
+    public:
+        using callback_type = typename Token::template callback_type<Callback>;
+
+        template <typename Init>
+        void emplace(const Token& token, Init&& init) noexcept(
+            std::is_nothrow_constructible_v<callback_type, const Token&, Init>)
+        {
+            cb_.emplace(token, static_cast<Init&&>(init));
+        }
+
+        void reset() noexcept { cb_.reset(); }
+
+    private:
+        std::optional<callback_type> cb_;
+    };
+
+    template <unstoppable_token Token, typename Callback>
+    class optional_stop_callback<Token, Callback>
+    {
+    public:
+        constexpr void emplace(const Token&, auto&&) noexcept {}
+        constexpr void reset() noexcept {}
+    };
+
     template <typename Callback>
     class in_place_stop_callback;
     class in_place_stop_source;
@@ -100,8 +134,9 @@ namespace clu
             callback_t callback_ = nullptr;
             in_place_stop_cb_base* prev_ = nullptr;
             in_place_stop_cb_base* next_ = nullptr;
+            bool* removed_during_exec_ = nullptr; // Points to a flag on the stack of the requesting thread
             std::atomic_uint8_t state_{};
-            bool removed_during_exec_ = false;
+            std::uint8_t stripe_ = 0; // Which list of the source this callback is in
 
             void execute() noexcept { callback_(this); }
             void attach() noexcept;
@@ -109,9 +144,17 @@ namespace clu
         };
     } // namespace detail
 
+    /**
+     * \brief A stop source for in_place_stop_token-s, which should outlive all the tokens and callbacks.
+     * \details The callbacks are kept in a few intrusive lists (stripes), each guarded by its own lock. A thread
+     * always registers its callbacks into the same stripe, so that callbacks registered or deregistered
+     * concurrently on different threads rarely contend on the same lock.
+     */
     class in_place_stop_source
     {
     public:
+        static constexpr std::size_t stripe_count = 4;
+
         constexpr in_place_stop_source() noexcept = default;
         in_place_stop_source(in_place_stop_source&&) noexcept = delete;
         ~in_place_stop_source() noexcept;
@@ -135,12 +178,13 @@ namespace clu
         static constexpr std::uint8_t completed = 2;
 
         std::atomic_bool requested_{};
-        locked_ptr<detail::in_place_stop_cb_base> callbacks_{};
+        locked_ptr<detail::in_place_stop_cb_base> callbacks_[stripe_count]{};
         std::thread::id requesting_thread_{}; // The thread which requested stop
 
         bool try_attach(detail::in_place_stop_cb_base* cb) noexcept;
         void detach(detail::in_place_stop_cb_base* cb) noexcept;
-        lock_result lock_if_not_requested() noexcept;
+        lock_result lock_if_not_requested(locked_ptr<detail::in_place_stop_cb_base>& list) noexcept;
+        static std::uint8_t current_stripe() noexcept;
     };
 
     class in_place_stop_token
@@ -0,0 +1,95 @@
+#include "clu/async/combining_mutex.h"
+
+namespace clu::async
+{
+    using detail::cmb_mtx::ops_base;
+
+    void start_ops(combining_mutex& self, ops_base& ops) noexcept
+    {
+        void* expected = self.waiting_.load(std::memory_order::relaxed);
+        while (true)
+        {
+            if (expected == &self) // Try to acquire lock synchronously
+            {
+                if (self.waiting_.compare_exchange_weak(
+                        expected, nullptr, std::memory_order::acquire, std::memory_order::relaxed))
+                    break;
+            }
+            else
+            {
+                ops.next = static_cast<ops_base*>(expected);
+                if (self.waiting_.compare_exchange_weak(
+                        expected, &ops, std::memory_order::release, std::memory_order::relaxed))
+                    return; // Enqueued ops into the waiting queue, the lock holder will execute it
+            }
+        }
+        self.combine(ops); // We are the lock holder now
+    }
+
+    namespace
+    {
+        void complete_all(ops_base* done) noexcept
+        {
+            while (done)
+            {
+                auto* next = done->next; // In case complete() destroys *done
+                done->complete();
+                done = next;
+            }
+        }
+    } // namespace
+
+    void combining_mutex::combine(ops_base& first) noexcept
+    {
+        first.execute();
+        first.next = nullptr;
+        ops_base* done = &first;
+        ops_base* done_tail = &first;
+        std::size_t done_count = 1;
+
+        // Execute the waiting operations in batches, until no one is waiting
+        void* expected = nullptr;
+        while (true)
+        {
+            if (expected == nullptr)
+            {
+                // No one is waiting, unlock
+                if (waiting_.compare_exchange_weak(
+                        expected, this, std::memory_order::release, std::memory_order::relaxed))
+                    break;
+            }
+            else if (waiting_.compare_exchange_weak(
+                         expected, nullptr, std::memory_order::acquire, std::memory_order::relaxed))
+            {
+                // Take the whole waiting queue, reverse it to get the FIFO order
+                auto* head = static_cast<ops_base*>(expected);
+                ops_base* batch = nullptr;
+                while (head)
+                {
+                    auto* ops = std::exchange(head, head->next);
+                    ops->next = std::exchange(batch, ops);
+                }
+                // Execute the critical sections while the data is still hot in our cache
+                while (batch)
+                {
+                    batch->execute();
+                    auto* ops = std::exchange(batch, batch->next);
+                    ops->next = nullptr;
+                    (done ? done_tail->next : done) = ops;
+                    done_tail = ops;
+                    // The waiters may keep coming, don't hold the finished operations back indefinitely.
+                    // The lock is still held here, operations started by the completions are just queued.
+                    if (++done_count == max_combine)
+                    {
+                        complete_all(std::exchange(done, nullptr));
+                        done_count = 0;
+                    }
+                }
+                expected = nullptr;
+            }
+        }
+
+        // Complete the rest of the operations after unlocking
+        complete_all(done);
+    }
+} // namespace clu::async
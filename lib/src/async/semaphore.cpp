@@ -0,0 +1,87 @@
+#include "clu/async/semaphore.h"
+
+#include <mutex>
+
+namespace clu::async
+{
+    using detail::sema::ops_base;
+
+    bool semaphore::try_acquire(const std::size_t n) noexcept { return try_acquire_fast(n); }
+
+    void semaphore::release(const std::size_t n) noexcept
+    {
+        // Fast path, no one is waiting
+        std::size_t state = state_.load(std::memory_order::relaxed);
+        while (!(state & waiting_bit))
+            if (state_.compare_exchange_weak(
+                    state, state + (n << 1), std::memory_order::release, std::memory_order::relaxed))
+                return;
+
+        // Someone is waiting, hand the units over to the waiting operations in order
+        auto* res = [&]() -> ops_base*
+        {
+            std::unique_lock lock(mut_);
+            std::size_t available = (state_.load(std::memory_order::relaxed) >> 1) + n;
+            ops_base* first = nullptr;
+            ops_base* last = nullptr;
+            while (head_ && head_->count <= available)
+            {
+                available -= head_->count;
+                last = std::exchange(head_, head_->next);
+                if (!first)
+                    first = last;
+            }
+            if (last)
+                last->next = nullptr;
+            if (!head_)
+                tail_ = nullptr;
+            state_.store((available << 1) | (head_ ? waiting_bit : 0), std::memory_order::release);
+            return first;
+        }();
+        while (res)
+        {
+            auto* next = res->next; // In case set() destroys *res
+            res->set();
+            res = next;
+        }
+    }
+
+    bool start_ops(semaphore& self, ops_base& ops) noexcept
+    {
+        if (self.try_acquire_fast(ops.count))
+            return false; // Acquired synchronously
+        std::unique_lock lock(self.mut_);
+        std::size_t state = self.state_.load(std::memory_order::relaxed);
+        while (!(state & semaphore::waiting_bit))
+        {
+            if ((state >> 1) >= ops.count) // Units got released in the meantime
+            {
+                if (self.state_.compare_exchange_weak(
+                        state, state - (ops.count << 1), std::memory_order::acquire, std::memory_order::relaxed))
+                    return false;
+            }
+            else if (self.state_.compare_exchange_weak(
+                         state, state | semaphore::waiting_bit, std::memory_order::relaxed))
+                break;
+        }
+        // Now the waiting bit is set, no one else could modify the state without the lock
+        ops.next = nullptr;
+        if (self.tail_)
+            self.tail_->next = &ops;
+        else
+            self.head_ = &ops;
+        self.tail_ = &ops;
+        return true;
+    }
+
+    bool semaphore::try_acquire_fast(const std::size_t n) noexcept
+    {
+        std::size_t state = state_.load(std::memory_order::relaxed);
+        // Don't overtake the waiting operations
+        while (!(state & waiting_bit) && (state >> 1) >= n)
+            if (state_.compare_exchange_weak(
+                    state, state - (n << 1), std::memory_order::acquire, std::memory_order::relaxed))
+                return true;
+        return false;
+    }
+} // namespace clu::async
@@ -8,13 +8,9 @@ namespace clu::async
 
     bool shared_mutex::try_lock() noexcept
     {
-        const std::unique_lock lock(mut_, std::try_to_lock);
-        if (lock && shared_holder_ == 0) // Not locked by anyone
-        {
-            shared_holder_ = unique_locked;
-            return true;
-        }
-        return false;
+        std::size_t expected = 0; // Not locked by anyone, also no one is waiting
+        return state_.compare_exchange_strong(
+            expected, slow_bit | unique_bit, std::memory_order::acquire, std::memory_order::relaxed);
     }
 
     void shared_mutex::unlock() noexcept
@@ -22,9 +18,8 @@ namespace clu::async
         auto* res = [this]
         {
             std::unique_lock lock(mut_);
-            CLU_ASSERT(shared_holder_ == unique_locked, //
+            CLU_ASSERT(state_.load(std::memory_order::relaxed) & unique_bit, //
                 "Trying to uniquely unlock a shared mutex but not holding the lock currently");
-            shared_holder_ = 0;
             return get_resumption_ops();
         }();
         while (res)
@@ -37,27 +32,41 @@ namespace clu::async
 
     bool shared_mutex::try_lock_shared() noexcept
     {
-        const std::unique_lock lock(mut_, std::try_to_lock);
         // Not uniquely locked, also no unique lock is waiting
-        if (lock && shared_holder_ != unique_locked && !waiting_ && !pending_)
-        {
-            shared_holder_++;
-            return true;
-        }
+        std::size_t state = state_.load(std::memory_order::relaxed);
+        while (!(state & slow_bit))
+            if (state_.compare_exchange_weak(
+                    state, state + shared_one, std::memory_order::acquire, std::memory_order::relaxed))
+                return true;
         return false;
     }
 
     void shared_mutex::unlock_shared() noexcept
     {
+        // Fast path, no one is waiting
+        std::size_t state = state_.load(std::memory_order::relaxed);
+        while (!(state & slow_bit))
+        {
+            CLU_ASSERT(state >= shared_one, //
+                "Trying to shared unlock a shared mutex but not holding the lock currently");
+            if (state_.compare_exchange_weak(
+                    state, state - shared_one, std::memory_order::release, std::memory_order::relaxed))
+                return;
+        }
+
         auto* res = [this]() -> ops_base*
         {
             std::unique_lock lock(mut_);
-            CLU_ASSERT(shared_holder_ > 0, //
+            // Acquire the critical sections of the readers that unlocked on the fast path,
+            // the waiter we may resume runs after them without touching state_ again
+            const std::size_t locked_state = state_.load(std::memory_order::acquire);
+            CLU_ASSERT(locked_state >= shared_one, //
                 "Trying to shared unlock a shared mutex but not holding the lock currently");
-            CLU_ASSERT(shared_holder_ != unique_locked,
+            CLU_ASSERT(!(locked_state & unique_bit),
                 "Trying to shared unlock a shared mutex but the mutex is currently locked uniquely");
-            if (--shared_holder_ == 0) // Last shared unlock
+            if (locked_state < 2 * shared_one) // Last shared unlock
                 return get_resumption_ops();
+            state_.store(locked_state - shared_one, std::memory_order::release);
             return nullptr;
         }();
         while (res)
@@ -79,10 +88,19 @@ namespace clu::async
     bool shared_mutex::enqueue_unique(ops_base& ops) noexcept
     {
         std::unique_lock lock(mut_);
-        if (shared_holder_ == 0)
+        std::size_t state = state_.load(std::memory_order::relaxed);
+        while (true)
         {
-            shared_holder_ = unique_locked;
-            return false; // Acquired the lock synchronously
+            if (state == 0)
+            {
+                if (state_.compare_exchange_weak(
+                        state, slow_bit | unique_bit, std::memory_order::acquire, std::memory_order::relaxed))
+                    return false; // Acquired the lock synchronously
+            }
+            // Stop the shared holders from using the fast path
+            else if ((state & slow_bit) ||
+                state_.compare_exchange_weak(state, state | slow_bit, std::memory_order::relaxed))
+                break;
         }
         ops.next = waiting_;
         waiting_ = &ops;
@@ -92,11 +110,11 @@ namespace clu::async
     bool shared_mutex::enqueue_shared(ops_base& ops) noexcept
     {
         std::unique_lock lock(mut_);
-        if (shared_holder_ != unique_locked && !waiting_ && !pending_)
-        {
-            shared_holder_++;
-            return false; // Acquired the lock synchronously
-        }
+        std::size_t state = state_.load(std::memory_order::relaxed);
+        while (!(state & slow_bit))
+            if (state_.compare_exchange_weak(
+                    state, state + shared_one, std::memory_order::acquire, std::memory_order::relaxed))
+                return false; // Acquired the lock synchronously
         ops.next = waiting_;
         waiting_ = &ops;
         return true;
@@ -116,11 +134,14 @@ namespace clu::async
                 pending_->next = std::exchange(prev, pending_);
             }
         }
-        if (!pending_)
-            return nullptr; // No one is waiting
+        if (!pending_) // No one is waiting, back to the fast path
+        {
+            state_.store(0, std::memory_order::release);
+            return nullptr;
+        }
         if (!pending_->shared) // Next one waiting is a unique lock
         {
-            shared_holder_ = unique_locked;
+            state_.store(slow_bit | unique_bit, std::memory_order::release);
             auto* result = std::exchange(pending_, pending_->next);
             result->next = nullptr;
             return result;
@@ -128,12 +149,16 @@ namespace clu::async
         // Find a contiguous subsequence of shared lock operation states
         auto* result = pending_;
         ops_base* last;
+        std::size_t shared_holders = 0;
         do
         {
             last = std::exchange(pending_, pending_->next);
-            shared_holder_++;
+            shared_holders++;
         } while (pending_ && pending_->shared);
         last->next = nullptr;
+        // Stay on the slow path if there are still unique locks waiting
+        state_.store((shared_holders * shared_one) | (pending_ || waiting_ ? slow_bit : 0), //
+            std::memory_order::release);
         return result;
     }
 } // namespace clu::async
@@ -2,6 +2,30 @@
 
 #include <unordered_set>
 #include <algorithm>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX // std::max and std::numeric_limits<T>::max are used below
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#elif defined(__linux__)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "clu/assertion.h"
+#include "clu/execution/any_scheduler.h"
+#include "clu/execution/algorithms/basic.h"
+#include "clu/execution/algorithms/consumers.h"
 
 namespace clu
 {
@@ -24,9 +48,12 @@ namespace clu
         public:
             ~hp_cache() noexcept
             {
-                // TODO: optimize this with batched return
-                for (std::size_t i = 0; i < size_; i++)
-                    hazard_pointer_default_domain().return_available_hp(ptrs_[i]);
+                if (size_ == 0)
+                    return;
+                // Chain the cached hp-s up and return them all at once
+                for (std::size_t i = 1; i < size_; i++)
+                    ptrs_[i - 1]->next_avail = ptrs_[i];
+                hazard_pointer_default_domain().return_available_hps(ptrs_[0], ptrs_[size_ - 1]);
             }
 
             bool try_push_back(hp_impl* ptr) noexcept
@@ -41,7 +68,7 @@ namespace clu
             {
                 if (size_ == 0)
                     return nullptr;
-                return ptrs_[size_--];
+                return ptrs_[--size_];
             }
 
         private:
@@ -65,13 +92,55 @@ namespace clu
         }
 
         auto now() noexcept { return clock::now(); }
+
+        void register_hp_heavy_fence() noexcept
+        {
+#if defined(__linux__)
+            // Needs to be done once before any expedited membarrier, if this fails the readers
+            // fall back to sequentially consistent fences
+            static const bool registered = []
+            {
+                const bool success = ::syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+                if (success)
+                    hp_membarrier_registered.store(true, std::memory_order::relaxed);
+                return success;
+            }();
+            (void)registered;
+#endif
+        }
+
+        void hp_heavy_fence() noexcept
+        {
+#if defined(_WIN32)
+            ::FlushProcessWriteBuffers();
+#else
+            if (hp_asymmetric_fence_available())
+            {
+#if defined(__linux__)
+                if (::syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0) != 0)
+                    std::terminate(); // The readers are relying on us, there's no way back
+#endif
+            }
+            else
+            {
+                CLU_GCC_WNO_TSAN
+                std::atomic_thread_fence(std::memory_order::seq_cst);
+                CLU_GCC_RESTORE_WARNING
+            }
+#endif
+        }
     } // namespace detail
 
     // ReSharper disable once CppPassValueParameterByConstReference
-    hazard_pointer_domain::hazard_pointer_domain(const allocator alloc) noexcept: alloc_(alloc) {}
+    hazard_pointer_domain::hazard_pointer_domain(const allocator alloc) noexcept: alloc_(alloc)
+    {
+        detail::register_hp_heavy_fence();
+    }
 
     hazard_pointer_domain::~hazard_pointer_domain() noexcept
     {
+        clear_reclamation_scheduler();
+
         // Folly leaks the pointers for the default domain, not necessary in this case.
         // The standard mandates that thread local objects (the cache) destructs before
         // static objects (the default domain).
@@ -136,12 +205,35 @@ namespace clu
         }
     }
 
+    // Takes at most count hp-s off the available list, linked by next_avail
+    detail::hp_impl* hazard_pointer_domain::try_acquire_available_hps(const std::size_t count) noexcept
+    {
+        auto* head = avail_.lock_and_load();
+        if (!head)
+        {
+            avail_.store_and_unlock(nullptr);
+            return nullptr;
+        }
+        auto* last = head;
+        for (std::size_t i = 1; i < count && last->next_avail; i++)
+            last = last->next_avail;
+        avail_.store_and_unlock(last->next_avail);
+        last->next_avail = nullptr;
+        return head;
+    }
+
     void hazard_pointer_domain::return_available_hp(detail::hp_impl* hp) noexcept
+    {
+        return_available_hps(hp, hp);
+    }
+
+    // Returns a chain of hp-s linked by next_avail
+    void hazard_pointer_domain::return_available_hps(detail::hp_impl* first, detail::hp_impl* last) noexcept
     {
         // TODO: maybe there's no need to lock, just do a CAS would be fine
         auto* head = avail_.lock_and_load();
-        hp->next_avail = head;
-        avail_.store_and_unlock(hp);
+        last->next_avail = head;
+        avail_.store_and_unlock(first);
     }
 
     void hazard_pointer_domain::retire_object(detail::hp_obj_node* node) noexcept
@@ -154,6 +246,7 @@ namespace clu
         const auto shard_idx =
             (std::hash<std::uintptr_t>()(reinterpret_cast<std::uintptr_t>(node)) >> ignored_bits) & shard_mask;
         auto& shard = retired_[shard_idx];
+        backlog_.fetch_add(1, std::memory_order::relaxed); // Before publishing, so that it never goes negative
         while (!shard.compare_exchange_weak(node->next_, node, //
             std::memory_order::acq_rel, std::memory_order::acquire))
         {
@@ -167,7 +260,10 @@ namespace clu
         auto count = check_retired_count();
         if (count == 0 && (count = check_due()) == 0)
             return;
-        reclaim(count); // TODO: asynchronous reclamation on other execution context?
+        if (async_reclaim_.load(std::memory_order::acquire))
+            request_async_reclaim(count);
+        else
+            reclaim(count);
     }
 
     std::int64_t hazard_pointer_domain::check_retired_count() noexcept
@@ -212,10 +308,8 @@ namespace clu
             }
             if (!empty)
             {
-                CLU_GCC_WNO_TSAN
-                std::atomic_thread_fence(std::memory_order::seq_cst);
-                CLU_GCC_RESTORE_WARNING
-                count -= reclaim_all_non_matching(lists, done);
+                detail::hp_heavy_fence(); // Pairs with the light fences in hazard_pointer::try_protect
+                count -= reclaim_all_non_matching(lists, done, std::numeric_limits<std::size_t>::max());
             }
             if (count)
                 retired_count_.fetch_add(count, std::memory_order::release);
@@ -227,7 +321,7 @@ namespace clu
     }
 
     std::int64_t hazard_pointer_domain::reclaim_all_non_matching(
-        const std::span<detail::hp_obj_node* const> lists, bool& done) noexcept
+        const std::span<detail::hp_obj_node* const> lists, bool& done, const std::size_t budget) noexcept
     {
         // Load protected pointers
         std::pmr::unordered_set<const void*> hazards(alloc_);
@@ -243,7 +337,8 @@ namespace clu
             while (list)
             {
                 auto* next = list->next_;
-                if (hazards.contains(list))
+                // Nodes over the budget are put back as if they were protected
+                if (hazards.contains(list) || std::cmp_greater_equal(count, budget))
                 {
                     list->next_ = std::exchange(unreclaimed, list);
                     if (!unreclaimed_tail)
@@ -260,6 +355,9 @@ namespace clu
                 done = false;
         }
 
+        backlog_.fetch_sub(static_cast<std::size_t>(count), std::memory_order::relaxed);
+        reclaimed_.fetch_add(static_cast<std::size_t>(count), std::memory_order::relaxed);
+
         // Add unreclaimed nodes back into the 0th shard
         if (unreclaimed)
             while (!retired_[0].compare_exchange_weak(unreclaimed_tail->next_, unreclaimed, //
@@ -269,6 +367,124 @@ namespace clu
         return count;
     }
 
+    void hazard_pointer_domain::set_reclamation_scheduler(
+        const exec::any_scheduler& schd, const std::size_t batch_size)
+    {
+        CLU_ASSERT(batch_size > 0, "The reclamation batch size of a hazard pointer domain must be positive");
+        auto ptr = std::make_unique<exec::any_scheduler>(schd);
+        {
+            std::unique_lock lock(schd_lock_);
+            schd_.swap(ptr);
+            batch_size_ = batch_size;
+        }
+        async_reclaim_.store(true, std::memory_order::release);
+    }
+
+    void hazard_pointer_domain::clear_reclamation_scheduler() noexcept
+    {
+        async_reclaim_.store(false, std::memory_order::release);
+        std::unique_ptr<exec::any_scheduler> ptr;
+        {
+            std::unique_lock lock(schd_lock_);
+            schd_.swap(ptr);
+        }
+        // Without a scheduler the in-flight run won't post another one, wait for it to finish
+        while (reclaim_requests_.load(std::memory_order::acquire) != 0)
+            std::this_thread::yield();
+    }
+
+    hazard_pointer_domain_stats hazard_pointer_domain::stats() const noexcept
+    {
+        return {
+            .backlog = backlog_.load(std::memory_order::relaxed),
+            .reclaimed = reclaimed_.load(std::memory_order::relaxed),
+            .async_runs = async_runs_.load(std::memory_order::relaxed) //
+        };
+    }
+
+    void hazard_pointer_domain::request_async_reclaim(const std::int64_t count) noexcept
+    {
+        // Published before the request, so that the run noticing the request also sees the count
+        requested_count_.fetch_add(count, std::memory_order::release);
+        // Only the first request posts a run, the later ones are noticed by that run
+        if (reclaim_requests_.fetch_add(1, std::memory_order::acq_rel) == 0)
+            post_async_reclaim();
+    }
+
+    void hazard_pointer_domain::post_async_reclaim() noexcept
+    {
+        std::optional<exec::any_scheduler> schd;
+        {
+            std::unique_lock lock(schd_lock_);
+            if (schd_)
+                schd.emplace(*schd_);
+        }
+        if (!schd)
+        {
+            fallback_reclaim();
+            return;
+        }
+        try
+        {
+            exec::start_detached(exec::schedule(*schd) //
+                | exec::then([this] { run_async_reclaim(); }) //
+                | exec::upon_error([this](auto&&) noexcept { fallback_reclaim(); }) //
+                | exec::upon_stopped([this]() noexcept { fallback_reclaim(); }));
+        }
+        catch (...)
+        {
+            fallback_reclaim();
+        }
+    }
+
+    void hazard_pointer_domain::run_async_reclaim() noexcept
+    {
+        async_runs_.fetch_add(1, std::memory_order::relaxed);
+        const std::size_t requests = reclaim_requests_.load(std::memory_order::acquire);
+        std::int64_t count = requested_count_.exchange(0, std::memory_order::acq_rel);
+        const std::size_t budget = [this]
+        {
+            std::unique_lock lock(schd_lock_);
+            return batch_size_;
+        }();
+
+        detail::hp_obj_node* lists[n_shards];
+        bool empty = true;
+        for (std::size_t i = 0; i < n_shards; i++)
+            if ((lists[i] = retired_[i].exchange(nullptr, std::memory_order::acq_rel)))
+                empty = false;
+        std::int64_t reclaimed = 0;
+        if (!empty)
+        {
+            bool done = true; // Objects retired during this run are left for the next request
+            detail::hp_heavy_fence(); // Pairs with the light fences in hazard_pointer::try_protect
+            reclaimed = reclaim_all_non_matching(lists, done, budget);
+        }
+        // The objects put back still count towards the next threshold
+        if ((count -= reclaimed))
+            retired_count_.fetch_add(count, std::memory_order::release);
+
+        // Finish if the budget is not used up and no one requested another run in the meantime,
+        // otherwise post the rest as another run to give other work on the context a chance
+        std::size_t expected = requests;
+        if (std::cmp_less(reclaimed, budget) &&
+            reclaim_requests_.compare_exchange_strong(
+                expected, 0, std::memory_order::acq_rel, std::memory_order::relaxed))
+            return;
+        reclaim_requests_.store(1, std::memory_order::relaxed);
+        post_async_reclaim();
+    }
+
+    // Reclaims on the current thread when the run could not be posted
+    void hazard_pointer_domain::fallback_reclaim() noexcept
+    {
+        reclaim(requested_count_.exchange(0, std::memory_order::acq_rel));
+        reclaim_requests_.store(0, std::memory_order::release);
+        // The requests which came in during the reclamation did not post a run, give their counts back
+        if (const auto count = requested_count_.exchange(0, std::memory_order::acq_rel))
+            retired_count_.fetch_add(count, std::memory_order::release);
+    }
+
     bool hazard_pointer_domain::no_retired() const noexcept
     {
         return std::ranges::none_of(retired_,
@@ -309,6 +525,61 @@ namespace clu
         hptr_->hazard.store(ptr, std::memory_order::release);
     }
 
+    void hazard_pointer::acquire_n(hazard_pointer_domain& domain, const std::span<hazard_pointer> hps)
+    {
+        std::size_t i = 0;
+        // Default domain, take as many as we can from the thread local cache
+        if (&domain == &hazard_pointer_default_domain())
+        {
+            auto& cache = detail::get_cache();
+            for (; i < hps.size(); i++)
+                if (!(hps[i].hptr_ = cache.try_pop_back()))
+                    break;
+        }
+        if (i == hps.size())
+            return;
+        // Then from the domain's available list in one go, allocate the rest
+        auto* hp = domain.try_acquire_available_hps(hps.size() - i);
+        for (; hp; i++)
+            hps[i].hptr_ = std::exchange(hp, hp->next_avail);
+        for (; i < hps.size(); i++)
+            hps[i].hptr_ = domain.allocate_hp();
+    }
+
+    void hazard_pointer::release_n(const std::span<hazard_pointer> hps) noexcept
+    {
+        detail::hp_cache* cache = nullptr;
+        detail::hp_impl* first = nullptr;
+        detail::hp_impl* last = nullptr;
+        for (auto& hp : hps)
+        {
+            auto* ptr = std::exchange(hp.hptr_, nullptr);
+            if (!ptr) // Moved out by the user
+                continue;
+            ptr->hazard.store(nullptr, std::memory_order::release);
+            if (ptr->domain == &hazard_pointer_default_domain())
+            {
+                if (!cache)
+                    cache = &detail::get_cache();
+                if (cache->try_push_back(ptr))
+                    continue;
+            }
+            // Chain the rest up and return them to the domain at once, the elements
+            // of an array could come from different domains if the user swapped them
+            if (first && first->domain != ptr->domain)
+            {
+                first->domain->return_available_hps(first, last);
+                first = nullptr;
+            }
+            if (first)
+                last = last->next_avail = ptr;
+            else
+                first = last = ptr;
+        }
+        if (first)
+            first->domain->return_available_hps(first, last);
+    }
+
     hazard_pointer make_hazard_pointer(hazard_pointer_domain& domain)
     {
         // Default domain, try getting a thread local hp
@@ -1,8 +1,7 @@
 #include "clu/concurrency/locked_ptr.h"
 
-#include <thread>
-
 #include "clu/assertion.h"
+#include "clu/concurrency/spinlock.h"
 
 namespace clu::detail::lck_ptr
 {
@@ -10,10 +9,13 @@ namespace clu::detail::lck_ptr
     constexpr std::uintptr_t locked_no_notify = 1;
     constexpr std::uintptr_t locked_should_notify = 2;
     constexpr std::uintptr_t mask = 3;
+    // Critical sections guarded by a locked_ptr are short, spin for a while before going to sleep
+    constexpr int max_spin_count = 64;
 
     void* lock_and_load(std::atomic_uintptr_t& value) noexcept
     {
         auto loaded = value.load(std::memory_order::relaxed);
+        int spin_count = 0;
         while (true)
             switch (loaded & mask)
             {
@@ -24,19 +26,22 @@ namespace clu::detail::lck_ptr
                     if (value.compare_exchange_weak(
                             loaded, locked_value, std::memory_order::acquire, std::memory_order::relaxed))
                         return reinterpret_cast<void*>(loaded); // NOLINT(performance-no-int-to-ptr)
-                    std::this_thread::yield();
-                    break;
+                    break; // loaded is updated by the failed CAS, try again
                 }
                 case locked_no_notify:
                 {
+                    if (spin_count < max_spin_count)
+                    {
+                        spin_count++;
+                        cpu_relax();
+                        loaded = value.load(std::memory_order::relaxed);
+                        break;
+                    }
                     // No one was waiting, change the state so that
                     // we could be notified
                     const auto notify_value = (loaded & ~mask) | locked_should_notify;
                     if (!value.compare_exchange_weak(loaded, notify_value, std::memory_order::relaxed))
-                    {
-                        std::this_thread::yield();
                         break;
-                    }
                     [[fallthrough]];
                 }
                 case locked_should_notify:
@@ -1,22 +1,211 @@
 #include "clu/concurrency/spinlock.h"
 
 #include <thread>
+#include <utility>
 
 namespace clu
 {
+    namespace detail
+    {
+        struct alignas(cache_line_size) mcs_node
+        {
+            std::atomic<mcs_node*> next = nullptr;
+            std::atomic_bool locked = false;
+            mcs_node* next_free = nullptr;
+        };
+
+        namespace
+        {
+            class exponential_backoff
+            {
+            public:
+                void pause() noexcept
+                {
+                    if (spins_ > max_spins)
+                    {
+                        std::this_thread::yield();
+                        return;
+                    }
+                    for (std::uint32_t i = 0; i < spins_; i++)
+                        cpu_relax();
+                    spins_ *= 2;
+                }
+
+            private:
+                static constexpr std::uint32_t max_spins = 1024;
+                std::uint32_t spins_ = 1;
+            };
+
+            // Queue nodes are recycled per thread
+            class mcs_node_pool
+            {
+            public:
+                mcs_node_pool() noexcept = default;
+                mcs_node_pool(const mcs_node_pool&) = delete;
+                mcs_node_pool& operator=(const mcs_node_pool&) = delete;
+
+                ~mcs_node_pool() noexcept
+                {
+                    while (head_)
+                        delete std::exchange(head_, head_->next_free);
+                }
+
+                mcs_node* acquire()
+                {
+                    if (!head_)
+                        return new mcs_node;
+                    return std::exchange(head_, head_->next_free);
+                }
+
+                void release(mcs_node* node) noexcept { node->next_free = std::exchange(head_, node); }
+
+            private:
+                mcs_node* head_ = nullptr;
+            };
+
+            mcs_node_pool& get_mcs_node_pool() noexcept
+            {
+                thread_local mcs_node_pool pool;
+                return pool;
+            }
+
+            // Spins until the predicate is satisfied, yields the thread every once in a while
+            template <typename Pred>
+            void spin_until(Pred pred) noexcept
+            {
+                constexpr int spin_count = 128;
+                int i = 0;
+                while (!pred())
+                {
+                    cpu_relax();
+                    if (++i == spin_count)
+                    {
+                        i = 0;
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        } // namespace
+    } // namespace detail
+
     void spinlock::lock() noexcept
     {
         int i = 0;
         while (locked_.test_and_set(std::memory_order::acquire))
         {
-            if (i++ == spin_count)
+            // Wait until the lock looks free before trying again, without writing to the cache line
+            while (locked_.test(std::memory_order::relaxed))
             {
-                i = 0;
-                std::this_thread::yield();
+                cpu_relax();
+                if (i++ == spin_count)
+                {
+                    i = 0;
+                    std::this_thread::yield();
+                }
             }
         }
     }
 
     void spinlock::unlock() noexcept { locked_.clear(std::memory_order::release); }
     bool spinlock::try_lock() noexcept { return !locked_.test_and_set(std::memory_order::acquire); }
+
+    void ttas_spinlock::lock() noexcept
+    {
+        detail::exponential_backoff backoff;
+        while (true)
+        {
+            if (!locked_.exchange(true, std::memory_order::acquire))
+                return;
+            while (locked_.load(std::memory_order::relaxed))
+                backoff.pause();
+        }
+    }
+
+    void ticket_spinlock::lock() noexcept
+    {
+        constexpr std::uint32_t spins_per_waiter = 32;
+        constexpr int yield_round = 64;
+        const std::uint32_t ticket = next_.fetch_add(1, std::memory_order::relaxed);
+        int round = 0;
+        while (true)
+        {
+            const std::uint32_t serving = serving_.load(std::memory_order::acquire);
+            if (serving == ticket)
+                return;
+            // The farther we are in the queue, the longer we can wait before checking again
+            if (++round == yield_round)
+            {
+                round = 0;
+                std::this_thread::yield();
+                continue;
+            }
+            const std::uint32_t spins = (ticket - serving) * spins_per_waiter;
+            for (std::uint32_t i = 0; i < spins; i++)
+                cpu_relax();
+        }
+    }
+
+    void ticket_spinlock::unlock() noexcept
+    {
+        // Only the holder modifies serving_
+        serving_.store(serving_.load(std::memory_order::relaxed) + 1, std::memory_order::release);
+    }
+
+    bool ticket_spinlock::try_lock() noexcept
+    {
+        std::uint32_t ticket = serving_.load(std::memory_order::acquire);
+        // Succeeds only if no one has taken a ticket since the last one was served
+        return next_.compare_exchange_strong(ticket, ticket + 1, //
+            std::memory_order::acquire, std::memory_order::relaxed);
+    }
+
+    void mcs_spinlock::lock()
+    {
+        auto& pool = detail::get_mcs_node_pool();
+        detail::mcs_node* node = pool.acquire();
+        node->next.store(nullptr, std::memory_order::relaxed);
+        node->locked.store(true, std::memory_order::relaxed);
+        if (detail::mcs_node* pred = tail_.exchange(node, std::memory_order::acq_rel))
+        {
+            pred->next.store(node, std::memory_order::release);
+            detail::spin_until([&] { return !node->locked.load(std::memory_order::acquire); });
+        }
+        owner_ = node;
+    }
+
+    void mcs_spinlock::unlock() noexcept
+    {
+        detail::mcs_node* node = owner_;
+        detail::mcs_node* succ = node->next.load(std::memory_order::acquire);
+        if (!succ)
+        {
+            // No one is waiting, try to reset the queue
+            detail::mcs_node* expected = node;
+            if (tail_.compare_exchange_strong(expected, nullptr, //
+                    std::memory_order::release, std::memory_order::relaxed))
+            {
+                detail::get_mcs_node_pool().release(node);
+                return;
+            }
+            // Someone has just enqueued, wait for the link
+            detail::spin_until([&] { return (succ = node->next.load(std::memory_order::acquire)) != nullptr; });
+        }
+        succ->locked.store(false, std::memory_order::release);
+        detail::get_mcs_node_pool().release(node);
+    }
+
+    bool mcs_spinlock::try_lock()
+    {
+        auto& pool = detail::get_mcs_node_pool();
+        detail::mcs_node* node = pool.acquire();
+        node->next.store(nullptr, std::memory_order::relaxed);
+        detail::mcs_node* expected = nullptr;
+        if (tail_.compare_exchange_strong(expected, node, std::memory_order::acquire, std::memory_order::relaxed))
+        {
+            owner_ = node;
+            return true;
+        }
+        pool.release(node);
+        return false;
+    }
 } // namespace clu
@@ -0,0 +1,121 @@
+#include "clu/concurrency/spsc_byte_ring.h"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace clu
+{
+    namespace
+    {
+#if defined(_WIN32)
+        std::size_t allocation_granularity() noexcept
+        {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return info.dwAllocationGranularity;
+        }
+
+        // Maps a region of size bytes twice back to back, returns nullptr on failure
+        std::byte* map_mirrored(const std::size_t size) noexcept
+        {
+            const HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32), static_cast<DWORD>(size), nullptr);
+            if (!mapping)
+                return nullptr;
+            std::byte* result = nullptr;
+            // Someone else may take the address range between releasing the reservation and mapping the views
+            constexpr int max_attempts = 8;
+            for (int i = 0; i < max_attempts && !result; i++)
+            {
+                void* address = VirtualAlloc(nullptr, size * 2, MEM_RESERVE, PAGE_NOACCESS);
+                if (!address)
+                    break;
+                VirtualFree(address, 0, MEM_RELEASE);
+                auto* first = static_cast<std::byte*>( //
+                    MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, address));
+                if (!first)
+                    continue;
+                if (!MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, first + size))
+                {
+                    UnmapViewOfFile(first);
+                    continue;
+                }
+                result = first;
+            }
+            CloseHandle(mapping); // The views keep the mapping alive
+            return result;
+        }
+
+        void unmap_mirrored(std::byte* ptr, const std::size_t size) noexcept
+        {
+            UnmapViewOfFile(ptr + size);
+            UnmapViewOfFile(ptr);
+        }
+#elif defined(__linux__)
+        std::size_t allocation_granularity() noexcept { return static_cast<std::size_t>(sysconf(_SC_PAGESIZE)); }
+
+        std::byte* map_mirrored(const std::size_t size) noexcept
+        {
+            const int fd = memfd_create("clu_spsc_byte_ring", MFD_CLOEXEC);
+            if (fd == -1)
+                return nullptr;
+            std::byte* result = nullptr;
+            if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+            {
+                // Reserve the whole range first, then map the file twice over it
+                void* address = mmap(nullptr, size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (address != MAP_FAILED)
+                {
+                    auto* first = static_cast<std::byte*>(address);
+                    if (mmap(first, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+                        mmap(first + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED)
+                        result = first;
+                    else
+                        munmap(address, size * 2);
+                }
+            }
+            close(fd); // The mappings keep the file alive
+            return result;
+        }
+
+        void unmap_mirrored(std::byte* ptr, const std::size_t size) noexcept { munmap(ptr, size * 2); }
+#else
+        std::size_t allocation_granularity() noexcept { return 1; }
+        std::byte* map_mirrored(std::size_t) noexcept { return nullptr; }
+        void unmap_mirrored(std::byte*, std::size_t) noexcept {}
+#endif
+    } // namespace
+
+    spsc_byte_ring::spsc_byte_ring(const std::size_t capacity, const bool mirrored)
+    {
+        CLU_ASSERT(capacity != 0, "the capacity of an spsc_byte_ring must not be zero");
+        if (mirrored)
+        {
+            const std::size_t size = std::bit_ceil((std::max)(capacity, allocation_granularity()));
+            if ((ptr_ = map_mirrored(size)))
+            {
+                mask_ = size - 1;
+                mirrored_ = true;
+                return;
+            }
+        }
+        const std::size_t size = std::bit_ceil(capacity);
+        ptr_ = new std::byte[size];
+        mask_ = size - 1;
+    }
+
+    spsc_byte_ring::~spsc_byte_ring() noexcept
+    {
+        if (mirrored_)
+            unmap_mirrored(ptr_, capacity());
+        else
+            delete[] ptr_;
+    }
+} // namespace clu
@@ -23,10 +23,10 @@ namespace clu
 
     void run_loop::enqueue(ops_base& ops)
     {
-        {
-            std::unique_lock lock(mutex_);
-            tail_ = (head_ ? tail_->state.next : head_) = &ops;
-        }
+        // Notify with the lock held, once the lock is released the loop
+        // might run this operation, finish, and get destroyed
+        std::unique_lock lock(mutex_);
+        tail_ = (head_ ? tail_->state.next : head_) = &ops;
         cv_.notify_one();
     }
 
@@ -2,20 +2,22 @@
 
 #include <thread>
 #include <mutex>
-#include <optional>
 
 #include "clu/scope.h"
 #include "clu/new.h"
 
 namespace clu::detail::static_tp
 {
+    namespace
+    {
+        thread_local const pool* current_pool = nullptr;
+        thread_local clock::time_point slice_start{};
+    }
+
     class pool::thread_res
     {
     public:
-        // clang-format off
-        template <typename Fn>
-        explicit thread_res(Fn&& func): thread_(static_cast<Fn&&>(func)) {}
-        // clang-format on
+        thread_res() = default;
 
         ~thread_res() noexcept
         {
@@ -23,6 +25,12 @@ namespace clu::detail::static_tp
                 "finish() should be called before the destruction of a static thread pool");
         }
 
+        template <typename Fn>
+        void start(Fn&& func)
+        {
+            thread_ = std::thread(static_cast<Fn&&>(func));
+        }
+
         void finish()
         {
             std::unique_lock lock(mutex_);
@@ -56,12 +64,14 @@ namespace clu::detail::static_tp
             return dequeue_with_lock(lock);
         }
 
-        std::optional<ops_base*> try_dequeue()
+        // Never waits, otherwise a worker stealing from an empty queue would sleep on
+        // the wrong condition variable while tasks pile up in its own queue
+        ops_base* try_dequeue()
         {
-            std::unique_lock lock(mutex_, std::try_to_lock);
-            if (lock.owns_lock())
-                return dequeue_with_lock(lock);
-            return std::nullopt;
+            const std::unique_lock lock(mutex_, std::try_to_lock);
+            if (!lock.owns_lock() || !head_)
+                return nullptr;
+            return pop_with_lock();
         }
 
     private:
@@ -83,6 +93,11 @@ namespace clu::detail::static_tp
             cv_.wait(lock, [this] { return head_ != nullptr || finishing_; });
             if (!head_)
                 return nullptr;
+            return pop_with_lock();
+        }
+
+        ops_base* pop_with_lock() noexcept
+        {
             ops_base* ptr = head_;
             head_ = head_->state.next;
             if (!head_)
@@ -91,6 +106,12 @@ namespace clu::detail::static_tp
         }
     };
 
+    clock::time_point current_slice_start(const pool* ctx) noexcept
+    {
+        // Other threads never start a slice, they would always look expired otherwise
+        return current_pool == ctx ? slice_start : clock::now();
+    }
+
     pool::pool(const std::size_t size): size_(size)
     {
         res_ = static_cast<thread_res*>(aligned_alloc_for<thread_res>(size));
@@ -98,7 +119,11 @@ namespace clu::detail::static_tp
         std::size_t i = 0;
         scope_fail _2([&] { std::destroy_n(res_, i); });
         for (i = 0; i < size; i++)
-            std::construct_at(res_ + i, [this, i] { work(i); });
+            std::construct_at(res_ + i);
+        // The workers steal from each other's queues, so only start them after all the queues are ready
+        scope_fail _3([&] { finish(); });
+        for (std::size_t j = 0; j < size; j++)
+            res_[j].start([this, j] { work(j); });
     }
 
     pool::~pool() noexcept
@@ -128,14 +153,18 @@ namespace clu::detail::static_tp
 
     void pool::work(const std::size_t index)
     {
+        current_pool = this;
         const auto get_task = [=, this]
         {
             for (std::size_t i = index; i < index + size_; i++)
-                if (const auto task = res_[i % size_].try_dequeue()) // acquired the lock
-                    return *task;
+                if (ops_base* task = res_[i % size_].try_dequeue())
+                    return task;
             return res_[index].dequeue();
         };
         while (ops_base* task = get_task())
+        {
+            slice_start = clock::now();
             task->set();
+        }
     }
 } // namespace clu::detail::static_tp
@@ -24,58 +24,71 @@ namespace clu
 
     in_place_stop_source::~in_place_stop_source() noexcept
     {
-        CLU_ASSERT(callbacks_.unsafe_load_relaxed() == nullptr,
-            "in_place_stop_source destroyed before the callbacks are done");
+        for ([[maybe_unused]] auto& list : callbacks_)
+            CLU_ASSERT(list.unsafe_load_relaxed() == nullptr,
+                "in_place_stop_source destroyed before the callbacks are done");
     }
 
     in_place_stop_token in_place_stop_source::get_token() noexcept { return in_place_stop_token(this); }
 
     bool in_place_stop_source::request_stop() noexcept
     {
-        auto [locked, current] = lock_if_not_requested();
-        if (!locked)
+        if (requested_.exchange(true, std::memory_order::acq_rel))
             return false;
+        // Read by the detaching threads only after they see a callback started, which is stored after this
         requesting_thread_ = std::this_thread::get_id();
-        requested_.store(true, std::memory_order::release);
-        while (current)
+        for (auto& list : callbacks_)
         {
-            // Detach the first callback
-            auto* new_head = current->next_;
-            if (new_head)
-                new_head->prev_ = nullptr;
-            current->state_.store(started, std::memory_order::release);
-            callbacks_.store_and_unlock(new_head);
-            // Now that we have released the lock, start executing the callback
-            current->execute();
-            if (!current->removed_during_exec_) // detach() not called during execute()
+            // No one can attach to the list anymore, since requested_ is already set
+            auto* current = list.lock_and_load();
+            while (current)
             {
-                // Change the state and notify
-                current->state_.store(completed, std::memory_order::release);
-                current->state_.notify_one();
+                // Detach the first callback
+                auto* new_head = current->next_;
+                if (new_head)
+                    new_head->prev_ = nullptr;
+                bool removed_during_exec = false;
+                current->removed_during_exec_ = &removed_during_exec;
+                current->state_.store(started, std::memory_order::relaxed);
+                list.store_and_unlock(new_head);
+                // Now that we have released the lock, start executing the callback
+                current->execute();
+                // The callback may be destroyed by now if detach() was called during execute()
+                if (!removed_during_exec)
+                {
+                    current->removed_during_exec_ = nullptr;
+                    // The detaching thread may destroy the callback right after seeing this
+                    current->state_.store(completed, std::memory_order::release);
+                }
+                current = list.lock_and_load();
             }
-            current = callbacks_.lock_and_load();
+            list.store_and_unlock(nullptr);
         }
-        callbacks_.store_and_unlock(nullptr);
         return true;
     }
 
     bool in_place_stop_source::try_attach(detail::in_place_stop_cb_base* cb) noexcept
     {
-        const auto [locked, head] = lock_if_not_requested();
+        const std::uint8_t stripe = current_stripe();
+        auto& list = callbacks_[stripe];
+        const auto [locked, head] = lock_if_not_requested(list);
         if (!locked)
             return false;
         // Add the new one before the current head
+        cb->stripe_ = stripe;
         cb->next_ = head;
         if (head)
             head->prev_ = cb;
-        callbacks_.store_and_unlock(cb);
+        list.store_and_unlock(cb);
         return true;
     }
 
     void in_place_stop_source::detach(detail::in_place_stop_cb_base* cb) noexcept
     {
-        auto* head = callbacks_.lock_and_load();
-        if (cb->state_.load(std::memory_order::acquire) == not_started)
+        auto& list = callbacks_[cb->stripe_];
+        auto* head = list.lock_and_load();
+        const std::uint8_t state = cb->state_.load(std::memory_order::acquire);
+        if (state == not_started)
         {
             // Hasn't started executing
             if (cb->next_)
@@ -83,35 +96,49 @@ namespace clu
             if (cb->prev_) // In list
             {
                 cb->prev_->next_ = cb->next_;
-                callbacks_.store_and_unlock(head);
+                list.store_and_unlock(head);
             }
             else // Is head of list
-                callbacks_.store_and_unlock(cb->next_);
+                list.store_and_unlock(cb->next_);
+            return;
         }
-        else
+        // Already started executing
+        const auto id = requesting_thread_;
+        list.store_and_unlock(head); // Just unlock, we won't modify the linked list
+        if (state == completed)
+            return;
+        if (std::this_thread::get_id() == id) // execute() called detach()
+            *cb->removed_during_exec_ = true;
+        else // Executing on a different thread, wait until the callback completes
         {
-            // Already started executing
-            const auto id = requesting_thread_;
-            callbacks_.store_and_unlock(head); // Just unlock, we won't modify the linked list
-            if (std::this_thread::get_id() == id) // execute() called detach()
-                cb->removed_during_exec_ = true;
-            else // Executing on a different thread
-                cb->state_.wait(started, std::memory_order::acquire); // Wait until the callback completes
+            // Not waiting on the atomic, since notifying after the store may touch a destroyed callback
+            while (cb->state_.load(std::memory_order::acquire) != completed)
+                std::this_thread::yield();
         }
     }
 
-    in_place_stop_source::lock_result in_place_stop_source::lock_if_not_requested() noexcept
+    in_place_stop_source::lock_result in_place_stop_source::lock_if_not_requested(
+        locked_ptr<detail::in_place_stop_cb_base>& list) noexcept
     {
         if (stop_requested())
             return {}; // Fast path
-        auto* head = callbacks_.lock_and_load();
+        auto* head = list.lock_and_load();
         // Check again in case someone changed the state
         // while we're trying to acquire the lock
         if (stop_requested())
         {
-            callbacks_.store_and_unlock(head);
+            list.store_and_unlock(head);
             return {};
         }
         return {true, head};
     }
+
+    std::uint8_t in_place_stop_source::current_stripe() noexcept
+    {
+        // Threads are assigned to the stripes round-robin
+        static std::atomic_uint8_t next_stripe{};
+        thread_local const auto stripe =
+            static_cast<std::uint8_t>(next_stripe.fetch_add(1, std::memory_order::relaxed) % stripe_count);
+        return stripe;
+    }
 } // namespace clu
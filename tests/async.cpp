@@ -1,5 +1,15 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
 
 #include "clu/async.h"
 #include "clu/execution_contexts.h"
@@ -72,3 +82,608 @@ TEST_CASE("async_manual_reset_event", "[async]")
         REQUIRE(out2 == 42);
     }
 }
+
+TEST_CASE("lock-free channels", "[async]")
+{
+    SECTION("spsc try operations")
+    {
+        auto chnl = clu::async::make_spsc_channel<int>(3);
+        REQUIRE_FALSE(chnl.try_receive().has_value());
+        for (int i = 0; i < 3; i++)
+            REQUIRE(chnl.try_send(i));
+        REQUIRE_FALSE(chnl.try_send(3));
+        REQUIRE(chnl.try_receive() == 0);
+        REQUIRE(chnl.try_send(3));
+        for (int i = 1; i < 4; i++)
+            REQUIRE(chnl.try_receive() == i);
+        REQUIRE_FALSE(chnl.try_receive().has_value());
+    }
+
+    SECTION("overflow policies")
+    {
+        namespace bop = clu::async::buffer_overflow_policies;
+        auto oldest = clu::async::make_mpmc_channel<int>(2, bop::drop_oldest);
+        auto latest = clu::async::make_spsc_channel<int>(2, bop::drop_latest);
+        for (int i = 0; i < 4; i++)
+        {
+            REQUIRE(oldest.try_send(i));
+            REQUIRE(latest.try_send(i));
+        }
+        REQUIRE(oldest.try_receive() == 2);
+        REQUIRE(oldest.try_receive() == 3);
+        REQUIRE(latest.try_receive() == 0);
+        REQUIRE(latest.try_receive() == 1);
+    }
+
+    SECTION("suspension")
+    {
+        clu::static_thread_pool tp(4);
+        auto chnl = clu::async::make_mpmc_channel<int>(4);
+        constexpr int count = 10000;
+        std::atomic_int sum = 0;
+
+        const auto producer = [&](const int offset) -> clu::task<void>
+        {
+            for (int i = 0; i < count; i++)
+                co_await chnl.send_async(offset + i);
+        };
+        const auto consumer = [&]() -> clu::task<void>
+        {
+            for (int i = 0; i < count; i++)
+                sum += co_await chnl.receive_async();
+        };
+
+        // clang-format off
+        clu::this_thread::sync_wait(
+            ex::on(
+                tp.get_scheduler(),
+                ex::when_all(
+                    producer(0), producer(count),
+                    consumer(), consumer()
+                )
+            )
+        );
+        // clang-format on
+        REQUIRE(sum == count * (2 * count - 1));
+    }
+
+    SECTION("spsc suspension")
+    {
+        clu::static_thread_pool tp(2);
+        auto chnl = clu::async::make_spsc_channel<int>(2);
+        constexpr int count = 10000;
+        int sum = 0;
+
+        const auto producer = [&]() -> clu::task<void>
+        {
+            for (int i = 0; i < count; i++)
+                co_await chnl.send_async(i);
+        };
+        const auto consumer = [&]() -> clu::task<void>
+        {
+            for (int i = 0; i < count; i++)
+                sum += co_await chnl.receive_async();
+        };
+
+        clu::this_thread::sync_wait(ex::on(tp.get_scheduler(), ex::when_all(producer(), consumer())));
+        REQUIRE(sum == count * (count - 1) / 2);
+    }
+
+    SECTION("cancel")
+    {
+        auto chnl = clu::async::make_spsc_channel<int>(1);
+        bool stopped = false;
+        ex::start_detached(chnl.receive_async() | ex::then([](int) {}) | ex::upon_stopped([&] { stopped = true; }));
+        REQUIRE_FALSE(stopped);
+        chnl.cancel();
+        REQUIRE(stopped);
+    }
+}
+
+TEST_CASE("channel batches", "[async]")
+{
+    SECTION("try receive many")
+    {
+        auto chnl = clu::async::make_channel<int>(4);
+        for (int i = 0; i < 3; i++)
+            REQUIRE(chnl.try_send(i));
+        std::array<int, 4> out{};
+        REQUIRE(chnl.try_receive_many(out) == 3);
+        REQUIRE(out == std::array{0, 1, 2, 0});
+        REQUIRE(chnl.try_receive_many(out) == 0);
+    }
+
+    SECTION("send many is not interleaved")
+    {
+        auto chnl = clu::async::make_channel<int>(2);
+        bool batch_done = false, single_done = false;
+        ex::start_detached(chnl.send_many(std::vector{0, 1, 2, 3, 4}) | ex::then([&] { batch_done = true; }));
+        ex::start_detached(chnl.send_async(5) | ex::then([&] { single_done = true; }));
+        REQUIRE_FALSE(batch_done);
+        std::vector<int> received;
+        while (auto value = chnl.try_receive())
+            received.push_back(*value);
+        REQUIRE(received == std::vector{0, 1, 2, 3, 4, 5});
+        REQUIRE(batch_done);
+        REQUIRE(single_done);
+    }
+
+    SECTION("receive many")
+    {
+        auto chnl = clu::async::make_channel<int>(0);
+        std::vector<int> received;
+        ex::start_detached(chnl.receive_many(3) | //
+            ex::then([&](std::vector<int> values) { received = std::move(values); }));
+        REQUIRE(received.empty());
+        bool sent = false;
+        ex::start_detached(chnl.send_many(std::array{1, 2, 3, 4}) | ex::then([&] { sent = true; }));
+        REQUIRE(received == std::vector{1, 2, 3});
+        REQUIRE_FALSE(sent);
+        REQUIRE(chnl.try_receive() == 4);
+        REQUIRE(sent);
+    }
+
+    SECTION("concurrent batches")
+    {
+        clu::static_thread_pool tp(4);
+        auto chnl = clu::async::make_channel<int>(16);
+        constexpr int batches = 1000;
+        constexpr int batch_size = 10;
+        std::atomic_int sum = 0;
+
+        const auto producer = [&]() -> clu::task<void>
+        {
+            std::vector<int> batch(batch_size);
+            for (int i = 0; i < batches; i++)
+            {
+                std::ranges::fill(batch, i);
+                co_await chnl.send_many(batch);
+            }
+        };
+        const auto consumer = [&]() -> clu::task<void>
+        {
+            int received = 0;
+            while (received < 2 * batches * batch_size)
+            {
+                const auto values = co_await chnl.receive_many(batch_size);
+                for (const int value : values)
+                    sum += value;
+                received += static_cast<int>(values.size());
+            }
+        };
+
+        clu::this_thread::sync_wait(ex::on(tp.get_scheduler(), ex::when_all(producer(), producer(), consumer())));
+        REQUIRE(sum == batches * (batches - 1) * batch_size);
+    }
+}
+
+TEST_CASE("broadcast channel", "[async]")
+{
+    namespace bop = clu::async::buffer_overflow_policies;
+
+    SECTION("every subscriber gets every value")
+    {
+        auto chnl = clu::async::make_broadcast_channel<int>(4);
+        auto sub1 = chnl.subscribe();
+        REQUIRE(chnl.try_send(1));
+        auto sub2 = chnl.subscribe(); // Only receives values sent after subscribing
+        REQUIRE(chnl.try_send(2));
+        std::vector<int> out1, out2;
+        while (sub1.try_receive([&](const int value) { out1.push_back(value); })) {}
+        while (sub2.try_receive([&](const int value) { out2.push_back(value); })) {}
+        REQUIRE(out1 == std::vector{1, 2});
+        REQUIRE(out2 == std::vector{2});
+    }
+
+    SECTION("no copies")
+    {
+        auto chnl = clu::async::make_broadcast_channel<std::vector<int>>(2);
+        auto sub1 = chnl.subscribe();
+        auto sub2 = chnl.subscribe();
+        const std::vector<int>* ptr1 = nullptr;
+        const std::vector<int>* ptr2 = nullptr;
+        ex::start_detached(sub1.receive_async() | ex::then([&](const std::vector<int>& vec) { ptr1 = &vec; }));
+        ex::start_detached(sub2.receive_async() | ex::then([&](const std::vector<int>& vec) { ptr2 = &vec; }));
+        REQUIRE(ptr1 == nullptr);
+        REQUIRE(chnl.try_send(std::vector{1, 2, 3}));
+        REQUIRE(ptr1 != nullptr);
+        REQUIRE(ptr1 == ptr2);
+    }
+
+    SECTION("suspend")
+    {
+        auto chnl = clu::async::make_broadcast_channel<int>(2);
+        auto fast = chnl.subscribe();
+        auto slow = chnl.subscribe();
+        const auto ignore = [](int) {};
+        REQUIRE(chnl.try_send(0));
+        REQUIRE(chnl.try_send(1));
+        REQUIRE(fast.try_receive(ignore));
+        REQUIRE(fast.try_receive(ignore));
+        REQUIRE_FALSE(chnl.try_send(2)); // Held back by the slow subscriber
+        bool sent = false;
+        ex::start_detached(chnl.send_async(2) | ex::then([&] { sent = true; }));
+        REQUIRE_FALSE(sent);
+        REQUIRE(slow.try_receive(ignore));
+        REQUIRE(sent);
+    }
+
+    SECTION("drop oldest")
+    {
+        auto chnl = clu::async::make_broadcast_channel<int>(2, bop::drop_oldest);
+        auto sub = chnl.subscribe();
+        for (int i = 0; i < 5; i++)
+            REQUIRE(chnl.try_send(i));
+        std::vector<int> out;
+        while (sub.try_receive([&](const int value) { out.push_back(value); })) {}
+        REQUIRE(out == std::vector{3, 4});
+    }
+
+    SECTION("unsubscribe")
+    {
+        auto chnl = clu::async::make_broadcast_channel<int>(1);
+        bool stopped = false;
+        {
+            auto sub = chnl.subscribe();
+            ex::start_detached(sub.receive_async() | ex::then([](int) {}) | ex::upon_stopped([&] { stopped = true; }));
+        }
+        REQUIRE(stopped);
+        REQUIRE(chnl.try_send(0)); // No one is subscribed
+        REQUIRE(chnl.try_send(1));
+    }
+
+    SECTION("concurrent")
+    {
+        clu::static_thread_pool tp(4);
+        auto chnl = clu::async::make_broadcast_channel<int>(8);
+        constexpr int count = 10000;
+        auto sub1 = chnl.subscribe();
+        auto sub2 = chnl.subscribe();
+        auto sub3 = chnl.subscribe();
+
+        const auto producer = [&]() -> clu::task<void>
+        {
+            for (int i = 0; i < count; i++)
+                co_await chnl.send_async(i);
+        };
+        const auto consumer = [&](decltype(chnl)::subscriber& sub) -> clu::task<bool>
+        {
+            for (int i = 0; i < count; i++)
+                if (co_await sub.receive_async() != i)
+                    co_return false;
+            co_return true;
+        };
+
+        const auto [ok1, ok2, ok3] = *clu::this_thread::sync_wait(
+            ex::on(tp.get_scheduler(), ex::when_all(producer(), consumer(sub1), consumer(sub2), consumer(sub3))));
+        REQUIRE(ok1);
+        REQUIRE(ok2);
+        REQUIRE(ok3);
+    }
+
+    SECTION("destroyed by a completion")
+    {
+        struct owner
+        {
+            clu::async::broadcast_channel<int> chnl{1};
+            clu::async::broadcast_channel<int>::subscriber sub = chnl.subscribe();
+        };
+        auto ptr = std::make_unique<owner>();
+        auto& chnl = ptr->chnl;
+        int received = 0;
+        ex::start_detached(ptr->sub.receive_async() |
+            ex::then(
+                [&](const int value)
+                {
+                    received = value;
+                    ptr.reset();
+                }));
+        REQUIRE(chnl.try_send(42)); // Completes the receiving operation inline
+        REQUIRE(received == 42);
+        REQUIRE_FALSE(ptr);
+    }
+
+    SECTION("destroyed right after the last receive completes")
+    {
+        clu::static_thread_pool tp(2);
+        for (int i = 0; i < 200; i++)
+        {
+            auto chnl = clu::async::make_broadcast_channel<int>(1);
+            auto sub = chnl.subscribe();
+            ex::start_detached(ex::schedule(tp.get_scheduler()) | ex::then([&] { (void)chnl.try_send(i); }));
+            // The sending thread may still be inside the channel when the receiving operation completes
+            const auto res = clu::this_thread::sync_wait(sub.receive_async());
+            REQUIRE(std::get<0>(*res) == i);
+        }
+    }
+}
+
+TEST_CASE("select", "[async]")
+{
+    SECTION("ready value")
+    {
+        auto ints = clu::async::make_channel<int>(1);
+        auto strs = clu::async::make_channel<std::string>(1);
+        REQUIRE(strs.try_send(std::string("hello")));
+        const auto res = clu::this_thread::sync_wait(clu::async::select(ints, strs));
+        REQUIRE(res);
+        const auto& [var] = *res;
+        REQUIRE(var.index() == 1);
+        REQUIRE(std::get<1>(var) == "hello");
+    }
+
+    SECTION("deregisters from the other channels")
+    {
+        auto first = clu::async::make_channel<int>(0);
+        auto second = clu::async::make_channel<int>(0);
+        std::variant<int, int> result;
+        bool done = false;
+        ex::start_detached(clu::async::select(first, second) | //
+            ex::then(
+                [&](const std::variant<int, int> var)
+                {
+                    result = var;
+                    done = true;
+                }));
+        REQUIRE_FALSE(done);
+        REQUIRE(second.try_send(42));
+        REQUIRE(done);
+        REQUIRE(result.index() == 1);
+        REQUIRE(std::get<1>(result) == 42);
+        // The select operation no longer waits on the first channel
+        REQUIRE_FALSE(first.try_send(1));
+        bool sent = false;
+        ex::start_detached(first.send_async(2) | ex::then([&] { sent = true; }));
+        REQUIRE_FALSE(sent);
+        REQUIRE(first.try_receive() == 2);
+        REQUIRE(sent);
+    }
+
+    SECTION("concurrent multiplexing")
+    {
+        clu::static_thread_pool tp(4);
+        auto first = clu::async::make_channel<int>(4);
+        auto second = clu::async::make_channel<int>(4);
+        constexpr int count = 2000;
+
+        const auto producer = [&](clu::async::channel<int>& chnl) -> clu::task<void>
+        {
+            for (int i = 0; i < count; i++)
+                co_await chnl.send_async(i);
+        };
+        std::array<int, 2> next{};
+        bool ordered = true;
+        const auto consumer = [&]() -> clu::task<void>
+        {
+            for (int i = 0; i < 2 * count; i++)
+            {
+                const auto var = co_await clu::async::select(first, second);
+                const int value = var.index() == 0 ? std::get<0>(var) : std::get<1>(var);
+                ordered = ordered && value == next[var.index()]++;
+            }
+        };
+
+        clu::this_thread::sync_wait(
+            ex::on(tp.get_scheduler(), ex::when_all(producer(first), producer(second), consumer())));
+        REQUIRE(ordered);
+        REQUIRE(next == std::array{count, count});
+    }
+}
+
+TEST_CASE("semaphore", "[async]")
+{
+    SECTION("try acquire")
+    {
+        clu::async::semaphore sema(3);
+        REQUIRE(sema.try_acquire(2));
+        REQUIRE_FALSE(sema.try_acquire(2));
+        REQUIRE(sema.try_acquire());
+        sema.release(3);
+        REQUIRE(sema.try_acquire(3));
+    }
+
+    SECTION("waiters are resumed in order")
+    {
+        clu::async::semaphore sema(1);
+        std::vector<int> order;
+        ex::start_detached(sema.acquire_async(2) | ex::then([&] { order.push_back(0); }));
+        ex::start_detached(sema.acquire_async() | ex::then([&] { order.push_back(1); }));
+        REQUIRE(order.empty());
+        REQUIRE_FALSE(sema.try_acquire()); // Doesn't overtake the waiters
+        sema.release();
+        REQUIRE(order == std::vector{0});
+        sema.release();
+        REQUIRE(order == std::vector{0, 1});
+        sema.release(2);
+        REQUIRE(sema.try_acquire(2));
+    }
+
+    SECTION("bounded concurrency")
+    {
+        clu::static_thread_pool tp(4);
+        clu::async::semaphore sema(2);
+        std::atomic_int running = 0;
+        std::atomic_int max_running = 0;
+        const auto worker = [&]() -> clu::task<void>
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                co_await sema.acquire_async();
+                const int current = ++running;
+                int expected = max_running.load();
+                while (current > expected && !max_running.compare_exchange_weak(expected, current)) {}
+                --running;
+                sema.release();
+            }
+        };
+        clu::this_thread::sync_wait(
+            ex::on(tp.get_scheduler(), ex::when_all(worker(), worker(), worker(), worker())));
+        REQUIRE(max_running <= 2);
+        REQUIRE(sema.try_acquire(2));
+    }
+}
+
+TEST_CASE("rate limiter", "[async]")
+{
+    clu::timer_thread_context timer;
+    clu::async::rate_limiter limiter(timer.get_scheduler(), 2, 10ms);
+
+    SECTION("try acquire")
+    {
+        REQUIRE(limiter.try_acquire(2));
+        REQUIRE_FALSE(limiter.try_acquire());
+    }
+
+    SECTION("throttling")
+    {
+        const auto start = chr::steady_clock::now();
+        const auto worker = [&]() -> clu::task<void>
+        {
+            for (int i = 0; i < 5; i++)
+                co_await limiter.acquire_async();
+        };
+        clu::static_thread_pool tp(2);
+        clu::this_thread::sync_wait(ex::on(tp.get_scheduler(), ex::when_all(worker(), worker())));
+        // 2 tokens are available initially, the other 8 take 80ms to refill
+        REQUIRE(chr::steady_clock::now() - start >= 75ms);
+    }
+}
+
+TEST_CASE("shared mutex", "[async]")
+{
+    SECTION("try lock")
+    {
+        clu::async::shared_mutex mut;
+        REQUIRE(mut.try_lock_shared());
+        REQUIRE(mut.try_lock_shared());
+        REQUIRE_FALSE(mut.try_lock());
+        mut.unlock_shared();
+        mut.unlock_shared();
+        REQUIRE(mut.try_lock());
+        REQUIRE_FALSE(mut.try_lock_shared());
+        mut.unlock();
+        REQUIRE(mut.try_lock_shared());
+        mut.unlock_shared();
+    }
+
+    SECTION("waiting writer blocks new readers")
+    {
+        clu::async::shared_mutex mut;
+        REQUIRE(mut.try_lock_shared());
+        bool writer = false, reader = false;
+        ex::start_detached(mut.lock_async() | ex::then([&] { writer = true; }));
+        REQUIRE_FALSE(writer);
+        REQUIRE_FALSE(mut.try_lock_shared());
+        ex::start_detached(mut.lock_shared_async() | ex::then([&] { reader = true; }));
+        REQUIRE_FALSE(reader);
+        mut.unlock_shared();
+        REQUIRE(writer);
+        REQUIRE_FALSE(reader);
+        mut.unlock();
+        REQUIRE(reader);
+        REQUIRE(mut.try_lock_shared()); // Back to the fast path
+        mut.unlock_shared();
+        mut.unlock_shared();
+        REQUIRE(mut.try_lock());
+        mut.unlock();
+    }
+
+    SECTION("concurrent readers and writers")
+    {
+        clu::static_thread_pool tp(4);
+        clu::async::shared_mutex mut;
+        int value = 0;
+        std::atomic_bool consistent = true;
+        const auto writer = [&]() -> clu::task<void>
+        {
+            for (int i = 0; i < 500; i++)
+            {
+                co_await mut.lock_async();
+                value++;
+                value++;
+                mut.unlock();
+            }
+        };
+        const auto reader = [&]() -> clu::task<void>
+        {
+            for (int i = 0; i < 2000; i++)
+            {
+                co_await mut.lock_shared_async();
+                if (value % 2 != 0)
+                    consistent = false;
+                mut.unlock_shared();
+            }
+        };
+        clu::this_thread::sync_wait(
+            ex::on(tp.get_scheduler(), ex::when_all(writer(), writer(), reader(), reader(), reader())));
+        REQUIRE(consistent);
+        REQUIRE(value == 2000);
+    }
+}
+
+TEST_CASE("combining mutex", "[async]")
+{
+    SECTION("results and errors")
+    {
+        clu::async::combining_mutex mut;
+        int value = 0;
+        const auto res = clu::this_thread::sync_wait(mut.run([&] { return ++value; }));
+        REQUIRE(res);
+        REQUIRE(std::get<0>(*res) == 1);
+        REQUIRE(clu::this_thread::sync_wait(mut.run([&] { value++; })));
+        REQUIRE(value == 2);
+        REQUIRE_THROWS_AS(clu::this_thread::sync_wait(mut.run([]() -> int { throw std::runtime_error("error"); })),
+            std::runtime_error);
+        // The mutex is still usable after an exception
+        REQUIRE(std::get<0>(*clu::this_thread::sync_wait(mut.run([&] { return value; }))) == 2);
+    }
+
+    SECTION("concurrent critical sections")
+    {
+        clu::static_thread_pool tp(4);
+        clu::async::combining_mutex mut;
+        std::vector<int> values;
+        std::atomic_int sum = 0;
+        constexpr int count = 2000;
+        const auto worker = [&](const int offset) -> clu::task<void>
+        {
+            for (int i = 0; i < count; i++)
+                sum += co_await mut.run(
+                    [&, i]
+                    {
+                        values.push_back(offset + i);
+                        return static_cast<int>(values.size());
+                    });
+        };
+        clu::this_thread::sync_wait(
+            ex::on(tp.get_scheduler(), ex::when_all(worker(0), worker(count), worker(2 * count), worker(3 * count))));
+        REQUIRE(values.size() == 4 * count);
+        REQUIRE(sum == 4 * count * (4 * count + 1) / 2); // Each size is seen exactly once
+        std::ranges::sort(values);
+        REQUIRE(std::ranges::equal(values, std::views::iota(0, 4 * count)));
+    }
+
+    SECTION("completions make progress under sustained contention")
+    {
+        // Every critical section queues another one, so the lock holder always finds a new waiter
+        clu::async::combining_mutex mut;
+        constexpr int total = 1000;
+        int executed = 0, completed = 0, completed_before_last = 0;
+        std::function<void()> submit = [&]
+        {
+            ex::start_detached(mut.run(
+                                   [&]
+                                   {
+                                       if (++executed < total)
+                                           submit();
+                                       else
+                                           completed_before_last = completed;
+                                   }) |
+                ex::then([&] { completed++; }));
+        };
+        submit();
+        REQUIRE(executed == total);
+        REQUIRE(completed == total);
+        REQUIRE(completed_before_last >= total - static_cast<int>(clu::async::combining_mutex::max_combine));
+    }
+}
@@ -0,0 +1,965 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "clu/concurrency.h"
+#include "clu/execution/any_scheduler.h"
+#include "clu/execution_contexts.h"
+
+namespace
+{
+    std::atomic_int live_nodes = 0;
+    std::atomic_int deleted_on_main_thread = 0;
+    const auto main_thread_id = std::this_thread::get_id();
+
+    struct node : clu::hazard_pointer_obj_base<node>
+    {
+        int value = 0;
+        explicit node(const int v) noexcept: value(v) { ++live_nodes; }
+        ~node() noexcept
+        {
+            --live_nodes;
+            if (std::this_thread::get_id() == main_thread_id)
+                ++deleted_on_main_thread;
+        }
+    };
+} // namespace
+
+TEST_CASE("hazard pointer", "[concurrency]")
+{
+    SECTION("protected objects are not reclaimed")
+    {
+        std::atomic<node*> src = new node(1);
+        auto hp = clu::make_hazard_pointer();
+        node* ptr = hp.protect(src);
+        REQUIRE(ptr->value == 1);
+        src.store(new node(2));
+        ptr->retire();
+        clu::hazard_pointer_clean_up();
+        REQUIRE(ptr->value == 1); // Still alive
+        REQUIRE(live_nodes == 2);
+        hp.reset_protection();
+        clu::hazard_pointer_clean_up();
+        REQUIRE(live_nodes == 1);
+        src.load()->retire();
+        clu::hazard_pointer_clean_up();
+        REQUIRE(live_nodes == 0);
+    }
+
+    SECTION("concurrent readers")
+    {
+        std::atomic<node*> src = new node(0);
+        std::atomic_bool stop = false;
+        std::atomic_bool consistent = true;
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 3; i++)
+            readers.emplace_back(
+                [&]
+                {
+                    while (!stop.load(std::memory_order::relaxed))
+                    {
+                        // Acquire and release the hazard pointers repeatedly to exercise the cache
+                        auto hp = clu::make_hazard_pointer();
+                        const node* ptr = hp.protect(src);
+                        if (ptr->value < 0)
+                            consistent = false;
+                    }
+                });
+        for (int i = 1; i <= 20000; i++)
+            src.exchange(new node(i))->retire();
+        stop = true;
+        for (auto& thread : readers)
+            thread.join();
+        src.load()->retire();
+        clu::hazard_pointer_clean_up();
+        REQUIRE(consistent);
+        REQUIRE(live_nodes == 0);
+    }
+}
+
+TEST_CASE("hazard pointer array", "[concurrency]")
+{
+    const auto test_domain = [](clu::hazard_pointer_domain& domain)
+    {
+        std::atomic<node*> srcs[3]{new node(0), new node(1), new node(2)};
+        {
+            auto hps = clu::make_hazard_pointer_array<3>(domain);
+            REQUIRE_FALSE(hps.empty());
+            for (std::size_t i = 0; i < hps.size(); i++)
+            {
+                REQUIRE_FALSE(hps[i].empty());
+                node* ptr = hps[i].protect(srcs[i]);
+                REQUIRE(ptr->value == static_cast<int>(i));
+                ptr->retire(std::default_delete<node>{}, domain);
+            }
+            clu::hazard_pointer_clean_up(domain);
+            REQUIRE(live_nodes == 3);
+            const auto moved = std::move(hps);
+            REQUIRE(hps.empty());
+            clu::hazard_pointer_clean_up(domain);
+            REQUIRE(live_nodes == 3);
+        }
+        clu::hazard_pointer_clean_up(domain);
+        REQUIRE(live_nodes == 0);
+        // Reuse the released records
+        auto hps = clu::make_hazard_pointer_array<4>(domain);
+        for (std::size_t i = 0; i < hps.size(); i++)
+            REQUIRE_FALSE(hps[i].empty());
+    };
+
+    SECTION("default domain") { test_domain(clu::hazard_pointer_default_domain()); }
+    SECTION("custom domain")
+    {
+        clu::hazard_pointer_domain domain;
+        test_domain(domain);
+    }
+}
+
+TEST_CASE("hazard pointer domain reclamation scheduler", "[concurrency]")
+{
+    clu::static_thread_pool tp(1);
+    clu::hazard_pointer_domain domain;
+    domain.set_reclamation_scheduler(tp.get_scheduler(), 100);
+    deleted_on_main_thread = 0;
+
+    constexpr int count = 5000;
+    std::atomic<node*> src = new node(0);
+    auto hp = clu::make_hazard_pointer(domain);
+    const node* protected_node = hp.protect(src);
+    for (int i = 1; i <= count; i++)
+        src.exchange(new node(i))->retire(domain);
+    // Nothing is reclaimed on the retiring thread
+    REQUIRE(deleted_on_main_thread == 0);
+    domain.clear_reclamation_scheduler();
+    REQUIRE(deleted_on_main_thread == 0);
+    REQUIRE(protected_node->value == 0);
+
+    const auto stats = domain.stats();
+    REQUIRE(stats.async_runs > 0);
+    REQUIRE(stats.backlog + stats.reclaimed == count);
+    REQUIRE(stats.reclaimed > 0);
+
+    hp.reset_protection();
+    src.load()->retire(domain);
+    domain.clean_up();
+    REQUIRE(domain.stats().backlog == 0);
+    REQUIRE(domain.stats().reclaimed == count + 1);
+    REQUIRE(live_nodes == 0);
+}
+
+TEST_CASE("hazard pointer domain reclamation scheduler keeps protected objects counted", "[concurrency]")
+{
+    clu::static_thread_pool tp(1);
+    clu::hazard_pointer_domain domain;
+    constexpr int threshold = 1000; // The minimum number of retired objects which triggers a reclamation
+    // The first retirement in a domain is reclaimed right away since the periodic reclamation is due,
+    // get that out of the way so that only reaching the threshold triggers the runs below
+    (new node(-1))->retire(domain);
+    REQUIRE(domain.stats().reclaimed == 1);
+
+    std::atomic<node*> src = new node(0);
+    auto hp = clu::make_hazard_pointer(domain);
+    (void)hp.protect(src);
+    domain.set_reclamation_scheduler(tp.get_scheduler());
+    for (int i = 1; i <= threshold; i++)
+        src.exchange(new node(i))->retire(domain);
+    domain.clear_reclamation_scheduler();
+    REQUIRE(domain.stats().reclaimed == threshold);
+
+    // The protected object put back by the run makes up the threshold together with the new ones
+    hp.reset_protection();
+    domain.set_reclamation_scheduler(tp.get_scheduler());
+    for (int i = threshold + 1; i < 2 * threshold; i++)
+        src.exchange(new node(i))->retire(domain);
+    domain.clear_reclamation_scheduler();
+    REQUIRE(domain.stats().reclaimed == 2 * threshold);
+    REQUIRE(domain.stats().backlog == 0);
+
+    src.load()->retire(domain);
+    domain.clean_up();
+    REQUIRE(live_nodes == 0);
+}
+
+TEST_CASE("concurrent hash map", "[concurrency]")
+{
+    SECTION("basic operations")
+    {
+        clu::concurrent_hash_map<std::string, int> map;
+        REQUIRE(map.empty());
+        REQUIRE(map.insert("one", 1));
+        REQUIRE_FALSE(map.insert("one", 2));
+        REQUIRE(map.find("one") == 1);
+        REQUIRE_FALSE(map.insert_or_assign("one", 3));
+        REQUIRE(map.find("one") == 3);
+        REQUIRE(map.insert_or_assign("two", 2));
+        REQUIRE(map.size() == 2);
+        REQUIRE(map.contains("two"));
+        REQUIRE_FALSE(map.find("three"));
+        REQUIRE(map.erase("one"));
+        REQUIRE_FALSE(map.erase("one"));
+        REQUIRE_FALSE(map.contains("one"));
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE_FALSE(map.contains("two"));
+    }
+
+    SECTION("growth")
+    {
+        clu::concurrent_hash_map<int, int> map(1);
+        constexpr int count = 10000;
+        int inserted = 0;
+        for (int i = 0; i < count; i++)
+            inserted += map.insert(i, i * 2);
+        REQUIRE(inserted == count);
+        REQUIRE(map.size() == count);
+        bool all_found = true;
+        for (int i = 0; i < count; i++)
+            if (map.find(i) != i * 2)
+                all_found = false;
+        REQUIRE(all_found);
+    }
+
+    SECTION("concurrent readers and writers")
+    {
+        clu::concurrent_hash_map<int, std::pair<int, int>> map(1);
+        constexpr int key_count = 1000;
+        std::atomic_bool stop = false;
+        std::atomic_bool consistent = true;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 3; i++)
+            threads.emplace_back(
+                [&]
+                {
+                    int key = 0;
+                    while (!stop.load(std::memory_order::relaxed))
+                    {
+                        map.visit(key,
+                            [&](const std::pair<int, int>& value)
+                            {
+                                if (value.first != key || value.second % key_count != key)
+                                    consistent = false;
+                            });
+                        key = (key + 1) % key_count;
+                    }
+                });
+        for (int i = 0; i < 2; i++)
+            threads.emplace_back(
+                [&, i]
+                {
+                    for (int j = 0; j < 20000; j++)
+                    {
+                        const int key = (j * 7 + i) % key_count;
+                        if (j % 3 == 0)
+                            map.erase(key);
+                        else
+                            map.insert_or_assign(key, std::pair{key, j * key_count + key});
+                    }
+                });
+        for (std::size_t i = 3; i < threads.size(); i++)
+            threads[i].join();
+        stop = true;
+        for (std::size_t i = 0; i < 3; i++)
+            threads[i].join();
+        REQUIRE(consistent);
+        std::size_t found = 0;
+        for (int i = 0; i < key_count; i++)
+            found += map.contains(i);
+        REQUIRE(found == map.size());
+    }
+}
+
+TEST_CASE("rcu cell", "[concurrency]")
+{
+    SECTION("snapshots outlive updates")
+    {
+        clu::rcu_cell<std::string> cell("hello");
+        const auto snap = cell.read();
+        REQUIRE(*snap == "hello");
+        cell.update([](std::string& str) { str += " world"; });
+        REQUIRE(*snap == "hello");
+        REQUIRE(cell.load() == "hello world");
+        cell.store("bye");
+        REQUIRE(cell.read(std::ranges::size) == 3);
+        REQUIRE_THROWS(cell.update([](std::string&) { throw std::runtime_error("error"); }));
+        REQUIRE(cell.load() == "bye");
+    }
+
+    SECTION("moved-from snapshots are empty")
+    {
+        clu::rcu_cell<std::string> cell("hello");
+        auto snap = cell.read();
+        auto moved = std::move(snap);
+        REQUIRE_FALSE(snap); // NOLINT(bugprone-use-after-move)
+        REQUIRE(snap.get() == nullptr); // NOLINT(bugprone-use-after-move)
+        REQUIRE(*moved == "hello");
+        snap = std::move(moved);
+        REQUIRE_FALSE(moved); // NOLINT(bugprone-use-after-move)
+        REQUIRE(*snap == "hello");
+    }
+
+    SECTION("concurrent readers")
+    {
+        struct config
+        {
+            int version = 0;
+            int copy = 0;
+        };
+        clu::rcu_cell<config> cell;
+        std::atomic_bool stop = false;
+        std::atomic_bool consistent = true;
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 3; i++)
+            readers.emplace_back(
+                [&]
+                {
+                    int last = 0;
+                    while (!stop.load(std::memory_order::relaxed))
+                    {
+                        const auto snap = cell.read();
+                        // Consistent, and never goes back in time
+                        if (snap->version != snap->copy || snap->version < last)
+                            consistent = false;
+                        last = snap->version;
+                    }
+                });
+        for (int i = 1; i <= 10000; i++)
+            cell.update(
+                [](config& cfg)
+                {
+                    cfg.version++;
+                    cfg.copy++;
+                });
+        stop = true;
+        for (auto& thread : readers)
+            thread.join();
+        REQUIRE(consistent);
+        REQUIRE(cell.load().version == 10000);
+    }
+}
+
+TEST_CASE("seqlocked", "[concurrency]")
+{
+    struct stats
+    {
+        std::uint64_t count = 0;
+        std::uint64_t sum = 0;
+        std::uint32_t max = 0;
+    };
+
+    SECTION("basic operations")
+    {
+        clu::seqlocked<stats> value;
+        REQUIRE(value.load().count == 0);
+        value.store({1, 2, 3});
+        REQUIRE((*value).sum == 2);
+        const auto old_max = value.invoke_with_lock([](stats& s) { return std::exchange(s.max, 42u); });
+        REQUIRE(old_max == 3);
+        REQUIRE(value.invoke_with_shared_lock([](const stats& s) { return s.max; }) == 42);
+        REQUIRE_THROWS(value.invoke_with_lock(
+            [](stats& s)
+            {
+                s.count = 100;
+                throw std::runtime_error("error");
+            }));
+        REQUIRE(value.load().count == 1);
+    }
+
+    SECTION("readers never see torn values")
+    {
+        clu::seqlocked<stats> value;
+        std::atomic_bool stop = false;
+        std::atomic_bool consistent = true;
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 3; i++)
+            readers.emplace_back(
+                [&]
+                {
+                    while (!stop.load(std::memory_order::relaxed))
+                    {
+                        const stats s = value.load();
+                        if (s.sum != s.count * (s.count + 1) / 2 || s.max != s.count)
+                            consistent = false;
+                    }
+                });
+        for (std::uint32_t i = 1; i <= 100000; i++)
+            value.invoke_with_lock(
+                [=](stats& s)
+                {
+                    s.count++;
+                    s.sum += i;
+                    s.max = i;
+                });
+        stop = true;
+        for (auto& thread : readers)
+            thread.join();
+        REQUIRE(consistent);
+        REQUIRE(value.load().count == 100000);
+    }
+}
+
+TEMPLATE_TEST_CASE("spinlocks", "[concurrency]", //
+    clu::spinlock, clu::ttas_spinlock, clu::ticket_spinlock, clu::mcs_spinlock)
+{
+    static_assert(clu::mutex_like<TestType>);
+
+    SECTION("try lock")
+    {
+        TestType lock;
+        REQUIRE(lock.try_lock());
+        REQUIRE_FALSE(lock.try_lock());
+        std::thread([&] { REQUIRE_FALSE(lock.try_lock()); }).join();
+        lock.unlock();
+        REQUIRE(lock.try_lock());
+        lock.unlock();
+    }
+
+    SECTION("mutual exclusion")
+    {
+        clu::locked<std::size_t, TestType> counter(0);
+        std::size_t plain_counter = 0;
+        TestType lock;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++)
+            threads.emplace_back(
+                [&]
+                {
+                    for (int j = 0; j < 20000; j++)
+                    {
+                        counter.invoke_with_lock([](std::size_t& c) { c++; });
+                        std::unique_lock guard(lock);
+                        plain_counter++;
+                    }
+                });
+        for (auto& thread : threads)
+            thread.join();
+        REQUIRE(counter.invoke_with_lock([](const std::size_t c) { return c; }) == 80000);
+        REQUIRE(plain_counter == 80000);
+    }
+}
+
+namespace
+{
+    // Throws on construction from multiples of 3
+    struct throwing_value
+    {
+        int value = 0;
+
+        explicit throwing_value(const int v): value(v)
+        {
+            if (v % 3 == 0)
+                throw std::runtime_error("multiple of 3");
+        }
+    };
+
+    // Emplaces elements whose constructors may throw while other threads are pushing and popping
+    template <typename Container>
+    void check_throwing_emplace()
+    {
+        constexpr int thread_count = 4;
+        constexpr int per_thread = 6000;
+        Container container;
+        std::atomic<std::int64_t> sum = 0;
+        std::atomic_int count = 0;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < thread_count; i++)
+            threads.emplace_back(
+                [&, i]
+                {
+                    std::int64_t local_sum = 0;
+                    int local_count = 0;
+                    for (int j = 0; j < per_thread; j++)
+                    {
+                        try
+                        {
+                            container.emplace(i * per_thread + j);
+                        }
+                        catch (const std::runtime_error&) {}
+                        if (j % 2 == 1)
+                            if (const auto item = container.try_pop())
+                            {
+                                local_sum += item->value;
+                                local_count++;
+                            }
+                    }
+                    sum += local_sum;
+                    count += local_count;
+                });
+        for (auto& thread : threads)
+            thread.join();
+        while (const auto item = container.try_pop())
+        {
+            sum += item->value;
+            ++count;
+        }
+        // Every element which is successfully constructed comes out exactly once
+        std::int64_t expected_sum = 0;
+        int expected_count = 0;
+        for (int v = 0; v < thread_count * per_thread; v++)
+            if (v % 3 != 0)
+            {
+                expected_sum += v;
+                expected_count++;
+            }
+        REQUIRE(count == expected_count);
+        REQUIRE(sum == expected_sum);
+    }
+} // namespace
+
+TEST_CASE("concurrent queue", "[concurrency]")
+{
+    SECTION("basic operations")
+    {
+        clu::concurrent_queue<std::unique_ptr<int>> queue;
+        REQUIRE(queue.empty());
+        REQUIRE_FALSE(queue.try_pop());
+        queue.push(std::make_unique<int>(1));
+        queue.emplace(new int(2));
+        REQUIRE_FALSE(queue.empty());
+        REQUIRE(**queue.try_pop() == 1);
+        REQUIRE(**queue.try_pop() == 2);
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("remaining elements are destroyed with the queue")
+    {
+        const auto counter = std::make_shared<int>();
+        {
+            clu::concurrent_queue<std::shared_ptr<int>> queue;
+            for (int i = 0; i < 10; i++)
+                queue.push(counter);
+            (void)queue.try_pop();
+            REQUIRE(counter.use_count() == 10);
+        }
+        REQUIRE(counter.use_count() == 1);
+    }
+
+    SECTION("multiple producers and consumers")
+    {
+        constexpr int producer_count = 4;
+        constexpr int consumer_count = 4;
+        constexpr int per_producer = 20000;
+        clu::concurrent_queue<std::pair<int, int>> queue;
+        std::atomic_int consumed = 0;
+        std::atomic_bool in_order = true;
+        std::atomic<std::int64_t> sum = 0;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < producer_count; i++)
+            threads.emplace_back(
+                [&, i]
+                {
+                    for (int j = 0; j < per_producer; j++)
+                        queue.push({i, j});
+                });
+        for (int i = 0; i < consumer_count; i++)
+            threads.emplace_back(
+                [&]
+                {
+                    int last[producer_count] = {-1, -1, -1, -1};
+                    std::int64_t local_sum = 0;
+                    while (consumed.load(std::memory_order::relaxed) < producer_count * per_producer)
+                    {
+                        if (const auto item = queue.try_pop())
+                        {
+                            const auto [producer, index] = *item;
+                            if (index <= last[producer]) // Items from the same producer come in order
+                                in_order = false;
+                            last[producer] = index;
+                            local_sum += index;
+                            consumed.fetch_add(1, std::memory_order::relaxed);
+                        }
+                    }
+                    sum += local_sum;
+                });
+        for (auto& thread : threads)
+            thread.join();
+        REQUIRE(in_order);
+        REQUIRE(sum == std::int64_t{producer_count} * per_producer * (per_producer - 1) / 2);
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("throwing constructors") { check_throwing_emplace<clu::concurrent_queue<throwing_value>>(); }
+}
+
+TEST_CASE("concurrent stack", "[concurrency]")
+{
+    SECTION("basic operations")
+    {
+        clu::concurrent_stack<std::string> stack;
+        REQUIRE(stack.empty());
+        REQUIRE_FALSE(stack.try_pop());
+        stack.push("one");
+        stack.emplace(std::size_t{3}, 'x');
+        REQUIRE(*stack.try_pop() == "xxx");
+        REQUIRE(*stack.try_pop() == "one");
+        REQUIRE(stack.empty());
+    }
+
+    SECTION("remaining elements are destroyed with the stack")
+    {
+        const auto counter = std::make_shared<int>();
+        {
+            clu::concurrent_stack<std::shared_ptr<int>> stack;
+            for (int i = 0; i < 10; i++)
+                stack.push(counter);
+            (void)stack.try_pop();
+            REQUIRE(counter.use_count() == 10);
+        }
+        REQUIRE(counter.use_count() == 1);
+    }
+
+    SECTION("concurrent pushes and pops")
+    {
+        constexpr int thread_count = 4;
+        constexpr int per_thread = 20000;
+        clu::concurrent_stack<int> stack;
+        std::atomic<std::int64_t> sum = 0;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < thread_count; i++)
+            threads.emplace_back(
+                [&]
+                {
+                    std::int64_t local_sum = 0;
+                    for (int j = 0; j < per_thread; j++)
+                    {
+                        stack.push(j);
+                        if (j % 2 == 1) // Pop about half of the elements while others are pushing
+                            if (const auto value = stack.try_pop())
+                                local_sum += *value;
+                    }
+                    sum += local_sum;
+                });
+        for (auto& thread : threads)
+            thread.join();
+        std::int64_t rest = 0;
+        while (const auto value = stack.try_pop())
+            rest += *value;
+        REQUIRE(sum + rest == std::int64_t{thread_count} * per_thread * (per_thread - 1) / 2);
+        REQUIRE(stack.empty());
+    }
+
+    SECTION("throwing constructors") { check_throwing_emplace<clu::concurrent_stack<throwing_value>>(); }
+}
+
+TEST_CASE("mpmc bounded queue", "[concurrency]")
+{
+    SECTION("basic operations")
+    {
+        clu::mpmc_bounded_queue<std::unique_ptr<int>> queue(3);
+        REQUIRE(queue.capacity() == 4);
+        REQUIRE_FALSE(queue.try_pop());
+        for (int i = 0; i < 4; i++)
+            REQUIRE(queue.try_push(std::make_unique<int>(i)));
+        REQUIRE_FALSE(queue.try_push(std::make_unique<int>(4)));
+        for (int i = 0; i < 4; i++)
+            REQUIRE(**queue.try_pop() == i);
+        REQUIRE_FALSE(queue.try_pop());
+    }
+
+    SECTION("bulk operations")
+    {
+        clu::mpmc_bounded_queue<std::string> queue(8);
+        std::vector<std::string> values{"a", "b", "c", "d", "e", "f"};
+        const auto moved = [&] // Copying strings may throw, so we move them in
+        {
+            return std::ranges::subrange( //
+                std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+        };
+        REQUIRE(queue.try_push_bulk(moved()) == 6);
+        values = {"a", "b", "c"};
+        REQUIRE(queue.try_push_bulk(moved()) == 2);
+        REQUIRE(values[2] == "c");
+        std::string out[5];
+        REQUIRE(queue.try_pop_bulk(out) == 5);
+        REQUIRE(out[0] == "a");
+        REQUIRE(out[4] == "e");
+        REQUIRE(queue.try_pop_bulk(out) == 3);
+        REQUIRE(out[0] == "f");
+        REQUIRE(out[2] == "b");
+        REQUIRE(queue.try_pop_bulk(out) == 0);
+    }
+
+    SECTION("remaining elements are destroyed with the queue")
+    {
+        const auto counter = std::make_shared<int>();
+        {
+            clu::mpmc_bounded_queue<std::shared_ptr<int>> queue(16);
+            for (int i = 0; i < 10; i++)
+                REQUIRE(queue.try_push(counter));
+            REQUIRE(counter.use_count() == 11);
+        }
+        REQUIRE(counter.use_count() == 1);
+    }
+
+    SECTION("multiple producers and consumers")
+    {
+        constexpr int producer_count = 4;
+        constexpr int consumer_count = 4;
+        constexpr int per_producer = 20000;
+        clu::mpmc_bounded_queue<int> queue(64);
+        std::atomic_int consumed = 0;
+        std::atomic<std::int64_t> sum = 0;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < producer_count; i++)
+            threads.emplace_back(
+                [&, i]
+                {
+                    int j = 0;
+                    while (j < per_producer)
+                    {
+                        int pushed = 0;
+                        if (i % 2 == 0) // Half of the producers push in batches
+                        {
+                            const int batch[] = {j, j + 1};
+                            const std::size_t size = j + 1 < per_producer ? 2 : 1;
+                            pushed = static_cast<int>(queue.try_push_bulk(std::span(batch, size)));
+                        }
+                        else
+                            pushed = queue.try_push(j) ? 1 : 0;
+                        if (pushed == 0) // Let the consumers run when there are fewer cores than threads
+                            std::this_thread::yield();
+                        j += pushed;
+                    }
+                });
+        for (int i = 0; i < consumer_count; i++)
+            threads.emplace_back(
+                [&, i]
+                {
+                    std::int64_t local_sum = 0;
+                    int buffer[8];
+                    while (consumed.load(std::memory_order::relaxed) < producer_count * per_producer)
+                    {
+                        int popped = 0;
+                        if (i % 2 == 0)
+                        {
+                            popped = static_cast<int>(queue.try_pop_bulk(buffer));
+                            for (int j = 0; j < popped; j++)
+                                local_sum += buffer[j];
+                        }
+                        else if (const auto value = queue.try_pop())
+                        {
+                            popped = 1;
+                            local_sum += *value;
+                        }
+                        if (popped == 0)
+                            std::this_thread::yield();
+                        consumed.fetch_add(popped, std::memory_order::relaxed);
+                    }
+                    sum += local_sum;
+                });
+        for (auto& thread : threads)
+            thread.join();
+        REQUIRE(sum == std::int64_t{producer_count} * per_producer * (per_producer - 1) / 2);
+        REQUIRE_FALSE(queue.try_pop());
+    }
+}
+
+namespace
+{
+    void check_spsc_byte_ring_basics(const bool mirrored)
+    {
+        clu::spsc_byte_ring ring(4096, mirrored);
+        REQUIRE(ring.capacity() >= 4096);
+        const std::size_t capacity = ring.capacity();
+
+        REQUIRE(ring.data().empty());
+        const auto buf = ring.prepare(3);
+        REQUIRE(buf.size() == 3);
+        std::memcpy(buf.data(), "abc", 3);
+        REQUIRE(ring.data().empty()); // Not committed yet
+        ring.commit(3);
+        const auto readable = ring.data();
+        REQUIRE(readable.size() == 3);
+        REQUIRE(std::memcmp(readable.data(), "abc", 3) == 0);
+        ring.consume(3);
+        REQUIRE(ring.prepare(capacity * 2).size() == (mirrored ? capacity : capacity - 3));
+
+        // Move the positions near the end of the storage
+        ring.commit(ring.prepare(capacity - 5).size());
+        REQUIRE(ring.data().size() == capacity - 5);
+        ring.consume(capacity - 5);
+        const auto wrapped = ring.prepare(4);
+        if (mirrored) // Always contiguous
+        {
+            REQUIRE(wrapped.size() == 4);
+            std::memcpy(wrapped.data(), "wxyz", 4);
+            ring.commit(4);
+            REQUIRE(ring.data().size() == 4);
+            REQUIRE(std::memcmp(ring.data().data(), "wxyz", 4) == 0);
+        }
+        else // Stops at the end of the storage
+        {
+            REQUIRE(wrapped.size() == 2);
+            ring.commit(2);
+            REQUIRE(ring.prepare(2).size() == 2);
+            ring.commit(2);
+            REQUIRE(ring.data().size() == 2);
+            ring.consume(2);
+            REQUIRE(ring.data().size() == 2);
+        }
+    }
+
+    void check_spsc_byte_ring_streaming(const bool mirrored)
+    {
+        constexpr std::size_t total = 1 << 20;
+        clu::spsc_byte_ring ring(4096, mirrored);
+        std::thread producer(
+            [&]
+            {
+                std::size_t written = 0;
+                while (written < total)
+                {
+                    const auto buf = ring.prepare((std::min)(total - written, std::size_t{1000}));
+                    if (buf.empty())
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (std::size_t i = 0; i < buf.size(); i++)
+                        buf[i] = static_cast<std::byte>((written + i) % 251);
+                    ring.commit(buf.size());
+                    written += buf.size();
+                }
+            });
+        std::size_t read = 0;
+        bool intact = true;
+        while (read < total)
+        {
+            const auto buf = ring.data();
+            if (buf.empty())
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::size_t i = 0; i < buf.size(); i++)
+                if (buf[i] != static_cast<std::byte>((read + i) % 251))
+                    intact = false;
+            ring.consume(buf.size());
+            read += buf.size();
+        }
+        producer.join();
+        REQUIRE(intact);
+    }
+} // namespace
+
+TEST_CASE("spsc byte ring", "[concurrency]")
+{
+    SECTION("plain")
+    {
+        check_spsc_byte_ring_basics(false);
+        check_spsc_byte_ring_streaming(false);
+    }
+
+    SECTION("mirrored")
+    {
+        clu::spsc_byte_ring ring(1);
+#ifdef __linux__
+        REQUIRE(ring.is_mirrored());
+#endif
+        if (ring.is_mirrored())
+        {
+            check_spsc_byte_ring_basics(true);
+            check_spsc_byte_ring_streaming(true);
+        }
+    }
+}
+
+TEST_CASE("concurrent event", "[concurrency]")
+{
+    SECTION("basic")
+    {
+        int v = 0;
+        clu::concurrent_event<int> ev;
+        ev(1); // No subscribers
+        ev += [&v](const int i) { v += i; };
+        const auto sub = (ev += [&v](const int i) { v += 2 * i; });
+        ev(42);
+        REQUIRE(v == 126);
+        v = 0;
+        ev -= sub;
+        ev(42);
+        REQUIRE(v == 42);
+    }
+
+    SECTION("subscribers are destroyed")
+    {
+        struct counted
+        {
+            std::shared_ptr<int> count;
+            void operator()(const int i) const { *count += i; }
+        };
+        const auto count = std::make_shared<int>(0);
+        {
+            clu::concurrent_event<int> ev;
+            std::vector<clu::concurrent_event<int>::subscription> subs;
+            for (int i = 0; i < 100; i++)
+                subs.push_back(ev.subscribe(counted{count}));
+            // Unsubscribing most of them compacts the snapshot
+            for (std::size_t i = 0; i < 90; i++)
+                ev.unsubscribe(subs[i]);
+            ev(1);
+            REQUIRE(*count == 10);
+            ev += counted{count};
+            ev(1);
+            REQUIRE(*count == 21);
+        }
+        clu::hazard_pointer_clean_up();
+        REQUIRE(count.use_count() == 1);
+    }
+
+    SECTION("invoked while subscribing and unsubscribing")
+    {
+        constexpr int subscriber_count = 1000;
+        clu::concurrent_event<> ev;
+        std::atomic_int permanent_calls = 0;
+        ev += [&] { ++permanent_calls; };
+        std::atomic_bool stop = false;
+        std::vector<std::thread> invokers;
+        for (int i = 0; i < 3; i++)
+            invokers.emplace_back(
+                [&]
+                {
+                    int invoked = 0;
+                    while (!stop.load(std::memory_order::relaxed))
+                    {
+                        ev();
+                        invoked++;
+                        std::this_thread::yield();
+                    }
+                    ev(); // Make sure that every invoker contributes
+                    permanent_calls -= invoked + 1;
+                });
+        std::atomic_int transient_calls = 0;
+        std::vector<clu::concurrent_event<>::subscription> subs;
+        for (int i = 0; i < subscriber_count; i++)
+        {
+            subs.push_back(ev.subscribe([&] { ++transient_calls; }));
+            if (i % 2 == 1)
+            {
+                ev.unsubscribe(subs.back());
+                subs.pop_back();
+            }
+            if (i % 64 == 0)
+                std::this_thread::yield();
+        }
+        for (const auto sub : subs) ev.unsubscribe(sub);
+        stop = true;
+        for (auto& thread : invokers)
+            thread.join();
+        REQUIRE(permanent_calls == 0); // The permanent subscriber is invoked exactly once per invocation
+        transient_calls = 0;
+        ev();
+        REQUIRE(transient_calls == 0);
+    }
+}
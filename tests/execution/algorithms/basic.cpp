@@ -404,3 +404,67 @@ TEST_CASE("into variant", "[execution]")
         REQUIRE_FALSE(res);
     }
 }
+
+TEST_CASE("repeat", "[execution]")
+{
+    SECTION("repeat n")
+    {
+        int count = 0;
+        REQUIRE(tt::sync_wait(ex::just_from([&] { count++; }) | ex::repeat_n(5)));
+        REQUIRE(count == 5);
+    }
+
+    SECTION("repeat zero times")
+    {
+        int count = 0;
+        REQUIRE(tt::sync_wait(ex::repeat_n(ex::just_from([&] { count++; }), 0)));
+        REQUIRE(count == 0);
+    }
+
+    SECTION("repeat until")
+    {
+        int count = 0;
+        REQUIRE(tt::sync_wait( //
+            ex::just_from([&] { count++; }) | ex::repeat_effect_until([&] { return count == 42; })));
+        REQUIRE(count == 42);
+    }
+
+    SECTION("deep loop does not overflow the stack")
+    {
+        std::size_t count = 0;
+        REQUIRE(tt::sync_wait(ex::just_from([&] { count++; }) | ex::repeat_n(1'000'000)));
+        REQUIRE(count == 1'000'000);
+    }
+
+    SECTION("error")
+    {
+        int count = 0;
+        REQUIRE_THROWS_WITH(tt::sync_wait( //
+                                ex::just_from(
+                                    [&]
+                                    {
+                                        if (++count == 3)
+                                            throw std::runtime_error("oh no");
+                                    }) //
+                                | ex::repeat_n(5)),
+            "oh no");
+        REQUIRE(count == 3);
+    }
+
+    SECTION("stop")
+    {
+        clu::in_place_stop_source src;
+        int count = 0;
+        const auto res = tt::sync_wait(ex::with_stop_token( //
+            ex::just_from(
+                [&]
+                {
+                    if (++count == 3)
+                        src.request_stop();
+                }) //
+                | ex::repeat_n(5),
+            src.get_token()));
+        REQUIRE_FALSE(res);
+        REQUIRE(count == 3);
+    }
+}
@@ -1,4 +1,5 @@
 #include <catch2/catch_test_macros.hpp>
+#include <system_error>
 
 #include "clu/execution/algorithms.h"
 #include "clu/execution_contexts.h"
@@ -40,3 +41,39 @@ TEST_CASE("execute", "[execution]")
 }
 
 // No need to test sync_wait since it's used everywhere in tests for other algorithms
+
+TEST_CASE("sync wait expected", "[execution]")
+{
+    SECTION("value")
+    {
+        const auto res = tt::sync_wait_expected(ex::just(42));
+        REQUIRE(res.has_value());
+        REQUIRE(res->has_value());
+        REQUIRE(std::get<0>(**res) == 42);
+    }
+
+    SECTION("error code")
+    {
+        const auto ec = std::make_error_code(std::errc::timed_out);
+        const auto res = tt::sync_wait_expected(ex::just_error(ec));
+        STATIC_REQUIRE(std::is_same_v<std::decay_t<decltype(res->error())>, std::error_code>);
+        REQUIRE(res.has_value());
+        REQUIRE_FALSE(res->has_value());
+        REQUIRE(res->error() == std::errc::timed_out);
+    }
+
+    SECTION("multiple error types")
+    {
+        const auto res = tt::sync_wait_expected( //
+            ex::just(1) | ex::let_value([](const int i) { return ex::just_error(i); }));
+        REQUIRE(res.has_value());
+        REQUIRE_FALSE(res->has_value());
+        REQUIRE(std::get<int>(res->error()) == 1);
+    }
+
+    SECTION("stopped")
+    {
+        const auto res = tt::sync_wait_expected(ex::just_stopped());
+        REQUIRE_FALSE(res.has_value());
+    }
+}
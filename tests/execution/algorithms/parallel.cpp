@@ -18,6 +18,22 @@ const auto then_fail = [] { return ex::then([] { FAIL(); }); };
 const auto then_throw = [](const char* msg) { return ex::then([=] { throw std::runtime_error(msg); }); };
 const auto then_stop = [] { return ex::let_value([] { return ex::stop(); }); };
 
+struct throw_on_copy_recv
+{
+    using is_receiver = void;
+
+    throw_on_copy_recv() noexcept = default;
+    throw_on_copy_recv(const throw_on_copy_recv&) { throw std::runtime_error("copy"); }
+    throw_on_copy_recv(throw_on_copy_recv&&) noexcept = default;
+    throw_on_copy_recv& operator=(const throw_on_copy_recv&) = delete;
+    ~throw_on_copy_recv() noexcept = default;
+
+    template <typename... Ts>
+    void tag_invoke(ex::set_value_t, Ts&&...) const noexcept {}
+    void tag_invoke(ex::set_error_t, std::exception_ptr) const noexcept {}
+    void tag_invoke(ex::set_stopped_t) const noexcept {}
+};
+
 TEST_CASE("when all", "[execution]")
 {
     SECTION("zero")
@@ -89,6 +105,55 @@ TEST_CASE("when all", "[execution]")
     }
 }
 
+TEST_CASE("when all range", "[execution]")
+{
+    SECTION("empty")
+    {
+        const auto res = tt::sync_wait(ex::when_all_range(std::vector<decltype(ex::just(0))>{}));
+        REQUIRE(res);
+        REQUIRE(std::get<0>(*res).empty());
+    }
+
+    SECTION("values in order")
+    {
+        std::vector<decltype(ex::just(0))> snds;
+        for (int i = 0; i < 100; i++) snds.push_back(ex::just(i));
+        const auto res = tt::sync_wait(ex::when_all_range(std::move(snds)));
+        REQUIRE(res);
+        const auto& vec = std::get<0>(*res);
+        REQUIRE(vec.size() == 100);
+        for (int i = 0; i < 100; i++) REQUIRE(vec[static_cast<std::size_t>(i)] == i);
+    }
+
+    SECTION("void")
+    {
+        std::atomic_size_t count = 0;
+        const auto add = [&](const std::size_t n) { return ex::just_from([&, n] { count.fetch_add(n, relaxed); }); };
+        std::vector snds{add(1), add(2), add(3)};
+        const auto res = tt::sync_wait(ex::when_all_range(std::move(snds)));
+        REQUIRE(res);
+        STATIC_REQUIRE(std::tuple_size_v<std::decay_t<decltype(*res)>> == 0);
+        REQUIRE(count.load(relaxed) == 6);
+    }
+
+    SECTION("early exit")
+    {
+        const auto wait_then = [](const std::chrono::milliseconds dur)
+        {
+            return ex::schedule_after(timer.get_scheduler(), dur) |
+                ex::then(
+                    [=]
+                    {
+                        if (dur < 10ms)
+                            throw std::runtime_error("yeet");
+                        FAIL();
+                    });
+        };
+        std::vector snds{wait_then(30ms), wait_then(5ms), wait_then(30ms)};
+        REQUIRE_THROWS_WITH(tt::sync_wait(ex::when_all_range(std::move(snds))), "yeet");
+    }
+}
+
 TEST_CASE("when any", "[execution]")
 {
     SECTION("zero")
@@ -311,3 +376,101 @@ TEST_CASE("detach on stop request", "[execution]")
         SECTION("also stopped") {}
     }
 }
+
+TEST_CASE("split", "[execution]")
+{
+    SECTION("shared result")
+    {
+        std::atomic_size_t count = 0;
+        auto snd = ex::just_from([&] { return static_cast<int>(count.fetch_add(1, relaxed)) + 42; }) | ex::split();
+        REQUIRE(count.load(relaxed) == 0); // Lazy
+        const auto res = tt::sync_wait(ex::when_all(snd, snd, snd));
+        REQUIRE(res);
+        REQUIRE(*res == std::tuple{42, 42, 42});
+        REQUIRE(count.load(relaxed) == 1);
+        const auto late = tt::sync_wait(snd); // Late subscriber completes inline
+        REQUIRE(late);
+        REQUIRE(std::get<0>(*late) == 42);
+        REQUIRE(count.load(relaxed) == 1);
+    }
+
+    SECTION("concurrent consumers")
+    {
+        auto snd = wait_short() | ex::then([] { return std::string("shared"); }) | ex::split();
+        const auto res = tt::sync_wait(ex::when_all( //
+            snd, snd | ex::then([](const std::string& str) { return str.size(); })));
+        REQUIRE(res);
+        const auto& [str, size] = *res;
+        REQUIRE(str == "shared");
+        REQUIRE(size == 6);
+    }
+
+    SECTION("error")
+    {
+        auto snd = ex::just() | then_throw("yeet") | ex::split();
+        REQUIRE_THROWS_WITH(tt::sync_wait(snd), "yeet");
+        REQUIRE_THROWS_WITH(tt::sync_wait(snd), "yeet");
+    }
+
+    SECTION("throwing receiver copy on connect")
+    {
+        auto ptr = std::make_shared<int>(42);
+        const std::weak_ptr<int> weak = ptr;
+        {
+            const auto snd = ex::just(std::move(ptr)) | ex::split();
+            const throw_on_copy_recv recv;
+            REQUIRE_THROWS_WITH(ex::connect(snd, recv), "copy");
+        }
+        REQUIRE(weak.expired()); // The shared state is not leaked
+    }
+}
+
+TEST_CASE("ensure started", "[execution]")
+{
+    SECTION("eager")
+    {
+        std::atomic_size_t count = 0;
+        auto snd = ex::just_from([&] { return count.fetch_add(1, relaxed) + 1; }) | ex::ensure_started();
+        REQUIRE(count.load(relaxed) == 1);
+        const auto res = tt::sync_wait(std::move(snd));
+        REQUIRE(res);
+        REQUIRE(std::get<0>(*res) == 1);
+    }
+
+    SECTION("move only result")
+    {
+        auto snd = wait_short() | ex::then([] { return std::make_unique<int>(42); }) | ex::ensure_started();
+        const auto res = tt::sync_wait(std::move(snd));
+        REQUIRE(res);
+        REQUIRE(*std::get<0>(*res) == 42);
+    }
+
+    SECTION("throwing receiver copy on connect")
+    {
+        auto ptr = std::make_shared<int>(42);
+        const std::weak_ptr<int> weak = ptr;
+        {
+            auto snd = ex::just(std::move(ptr)) | ex::ensure_started();
+            const throw_on_copy_recv recv;
+            REQUIRE_THROWS_WITH(ex::connect(std::move(snd), recv), "copy");
+        }
+        REQUIRE(weak.expired()); // The sender still owns the shared state after the failed connect
+    }
+
+    SECTION("detached")
+    {
+        std::atomic_flag stopped;
+        {
+            auto snd = wait_long() |
+                ex::upon_stopped(
+                    [&]
+                    {
+                        stopped.test_and_set(relaxed);
+                        stopped.notify_one();
+                    }) |
+                ex::ensure_started();
+        } // Dropped without being connected, the operation gets cancelled
+        stopped.wait(false, relaxed);
+        REQUIRE(stopped.test(relaxed));
+    }
+}
@@ -45,3 +45,54 @@ TEST_CASE("schedule from", "[execution]")
         REQUIRE(id2 == ctx.get_id());
     }
 }
+
+TEST_CASE("yield if expired", "[execution]")
+{
+    using namespace std::literals;
+
+    SECTION("pass through without time slices")
+    {
+        const auto res = tt::sync_wait(ex::just(42) | ex::yield_if_expired(0ms));
+        REQUIRE(res);
+        REQUIRE(std::get<0>(*res) == 42);
+    }
+
+    SECTION("yield to queued work")
+    {
+        clu::static_thread_pool pool(1);
+        const auto schd = pool.get_scheduler();
+        const auto test = [&](const auto budget)
+        {
+            std::atomic_bool other_done = false;
+            const auto spin = [] // Long synchronous step
+            {
+                const auto start = std::chrono::steady_clock::now();
+                while (std::chrono::steady_clock::now() - start < 5ms) {}
+            };
+            const auto res = tt::sync_wait(ex::when_all( //
+                ex::on(schd,
+                    ex::just() | ex::then(spin) | ex::yield_if_expired(budget) //
+                        | ex::then([&] { return other_done.load(); })),
+                ex::schedule(schd) | ex::then([&] { other_done = true; })));
+            REQUIRE(res);
+            return std::get<0>(*res);
+        };
+        REQUIRE(test(1ms)); // Expired, the other task runs first
+        REQUIRE_FALSE(test(1h)); // Still within budget, continues inline
+        pool.finish();
+    }
+
+    SECTION("no expired time slices outside of the workers")
+    {
+        clu::static_thread_pool pool(1), other(1);
+        const auto schd = pool.get_scheduler();
+        const auto before = std::chrono::steady_clock::now();
+        REQUIRE(ex::get_time_slice(schd) >= before);
+        const auto res = tt::sync_wait(ex::on(other.get_scheduler(),
+            ex::just() | ex::then([&] { return ex::get_time_slice(schd) >= std::chrono::steady_clock::now(); })));
+        REQUIRE(res);
+        REQUIRE(std::get<0>(*res));
+        pool.finish();
+        other.finish();
+    }
+}
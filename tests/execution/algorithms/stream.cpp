@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+
+#include <algorithm>
+
+#include "clu/execution/algorithms.h"
+#include "clu/execution_contexts.h"
+
+namespace ex = clu::exec;
+namespace tt = clu::this_thread;
+
+TEST_CASE("zip", "[execution]")
+{
+    SECTION("lock-step")
+    {
+        const auto res = tt::sync_wait( //
+            ex::zip(ex::as_stream(std::vector{1, 2, 3}), ex::as_stream(std::vector{'a', 'b', 'c'})) //
+            | ex::upon_each([](const int i, const char c) { return std::pair{i, c}; }) //
+            | ex::into_vector());
+        REQUIRE(res);
+        const auto& [vec] = *res;
+        REQUIRE(vec == std::vector<std::pair<int, char>>{{1, 'a'}, {2, 'b'}, {3, 'c'}});
+    }
+
+    SECTION("ends with the shortest stream")
+    {
+        const auto res = tt::sync_wait( //
+            ex::zip(ex::as_stream(std::vector{1, 2, 3}), ex::as_stream(std::vector{4})) //
+            | ex::upon_each([](const int i, const int j) { return i + j; }) //
+            | ex::into_vector());
+        REQUIRE(res);
+        REQUIRE(std::get<0>(*res) == std::vector{5});
+    }
+}
+
+TEST_CASE("merge", "[execution]")
+{
+    SECTION("single")
+    {
+        const auto res = tt::sync_wait(ex::merge(ex::as_stream(std::vector{1, 2, 3})) | ex::into_vector());
+        REQUIRE(res);
+        REQUIRE(std::get<0>(*res) == std::vector{1, 2, 3});
+    }
+
+    SECTION("interleave")
+    {
+        const auto res = tt::sync_wait( //
+            ex::merge(ex::as_stream(std::vector{1, 2, 3}), ex::empty_stream(), ex::as_stream(std::vector{4, 5})) //
+            | ex::into_vector());
+        REQUIRE(res);
+        auto vec = std::get<0>(*res);
+        std::ranges::sort(vec);
+        REQUIRE(vec == std::vector{1, 2, 3, 4, 5});
+    }
+
+    SECTION("concurrent sources")
+    {
+        clu::single_thread_context ctx1, ctx2;
+        const auto res = tt::sync_wait( //
+            ex::merge( //
+                ex::each_on(ex::as_stream(std::vector{1, 3, 5, 7}), ctx1.get_scheduler()),
+                ex::each_on(ex::as_stream(std::vector{2, 4, 6, 8}), ctx2.get_scheduler())) //
+            | ex::into_vector());
+        REQUIRE(res);
+        auto vec = std::get<0>(*res);
+        std::ranges::sort(vec);
+        REQUIRE(vec == std::vector{1, 2, 3, 4, 5, 6, 7, 8});
+    }
+
+    SECTION("error")
+    {
+        REQUIRE_THROWS_WITH(tt::sync_wait( //
+                                ex::merge(ex::as_stream(std::vector{1, 2, 3}) //
+                                    | ex::upon_each(
+                                        [](const int i)
+                                        {
+                                            if (i == 2)
+                                                throw std::runtime_error("oh no");
+                                            return i;
+                                        })) //
+                                | ex::into_vector()),
+            "oh no");
+    }
+}
@@ -0,0 +1,200 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "clu/stop_token.h"
+
+namespace
+{
+    struct flag_setter
+    {
+        bool* flag;
+        void operator()() const noexcept { *flag = true; }
+    };
+
+    using set_callback = clu::in_place_stop_callback<flag_setter>;
+} // namespace
+
+TEST_CASE("in place stop callback", "[stop_token]")
+{
+    SECTION("invoked on stop request")
+    {
+        clu::in_place_stop_source src;
+        bool invoked = false;
+        const set_callback cb(src.get_token(), flag_setter{&invoked});
+        REQUIRE_FALSE(invoked);
+        REQUIRE(src.request_stop());
+        REQUIRE(invoked);
+        REQUIRE_FALSE(src.request_stop());
+    }
+
+    SECTION("invoked inline if stop is already requested")
+    {
+        clu::in_place_stop_source src;
+        (void)src.request_stop();
+        bool invoked = false;
+        const set_callback cb(src.get_token(), flag_setter{&invoked});
+        REQUIRE(invoked);
+    }
+
+    SECTION("not invoked after deregistration")
+    {
+        clu::in_place_stop_source src;
+        bool first = false, second = false, third = false;
+        const set_callback cb1(src.get_token(), flag_setter{&first});
+        {
+            const set_callback cb2(src.get_token(), flag_setter{&second});
+        }
+        const set_callback cb3(src.get_token(), flag_setter{&third});
+        (void)src.request_stop();
+        REQUIRE(first);
+        REQUIRE_FALSE(second);
+        REQUIRE(third);
+    }
+
+    SECTION("default constructed token")
+    {
+        bool invoked = false;
+        const set_callback cb(clu::in_place_stop_token{}, flag_setter{&invoked});
+        REQUIRE_FALSE(invoked);
+    }
+}
+
+TEST_CASE("in place stop callback destroyed during its execution", "[stop_token]")
+{
+    clu::in_place_stop_source src;
+    using callback = clu::in_place_stop_callback<std::function<void()>>;
+    std::optional<callback> self_destroying;
+    bool other_invoked = false;
+    const set_callback other(src.get_token(), flag_setter{&other_invoked});
+    int invoke_count = 0;
+    self_destroying.emplace(src.get_token(),
+        [&]
+        {
+            invoke_count++;
+            self_destroying.reset(); // Must not touch the callback after this
+        });
+    (void)src.request_stop();
+    REQUIRE(invoke_count == 1);
+    REQUIRE_FALSE(self_destroying);
+    REQUIRE(other_invoked);
+}
+
+TEST_CASE("in place stop callback deregistered on another thread during execution", "[stop_token]")
+{
+    clu::in_place_stop_source src;
+    std::atomic_bool started = false;
+    std::atomic_bool release = false;
+    bool completed = false;
+    auto cb = std::make_unique<clu::in_place_stop_callback<std::function<void()>>>(src.get_token(),
+        [&]
+        {
+            started.store(true);
+            while (!release.load())
+                std::this_thread::yield();
+            completed = true;
+        });
+    std::thread requester([&] { (void)src.request_stop(); });
+    while (!started.load())
+        std::this_thread::yield();
+    release.store(true);
+    cb.reset(); // Blocks until the callback completes
+    REQUIRE(completed);
+    requester.join();
+}
+
+TEST_CASE("in place stop callbacks registered concurrently", "[stop_token]")
+{
+    constexpr std::size_t thread_count = 8;
+    constexpr std::size_t callbacks_per_thread = 200;
+    using callback = clu::in_place_stop_callback<std::function<void()>>;
+
+    SECTION("all invoked")
+    {
+        clu::in_place_stop_source src;
+        std::atomic_size_t invoked = 0;
+        std::atomic_size_t registered = 0;
+        std::atomic_bool done = false;
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < thread_count; i++)
+            threads.emplace_back(
+                [&]
+                {
+                    std::vector<std::unique_ptr<callback>> callbacks;
+                    for (std::size_t j = 0; j < callbacks_per_thread; j++)
+                        callbacks.push_back(std::make_unique<callback>(src.get_token(), [&] { ++invoked; }));
+                    ++registered;
+                    while (!done.load())
+                        std::this_thread::yield();
+                });
+        while (registered.load() != thread_count)
+            std::this_thread::yield();
+        (void)src.request_stop();
+        REQUIRE(invoked.load() == thread_count * callbacks_per_thread);
+        done.store(true);
+        for (auto& thread : threads) thread.join();
+    }
+
+    SECTION("registered and deregistered while stop is requested")
+    {
+        clu::in_place_stop_source src;
+        std::atomic_size_t invoked = 0;
+        std::atomic_size_t not_invoked = 0;
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < thread_count; i++)
+            threads.emplace_back(
+                [&]
+                {
+                    for (std::size_t j = 0; j < callbacks_per_thread; j++)
+                    {
+                        bool flag = false;
+                        {
+                            const callback cb(src.get_token(), [&] { flag = true; });
+                            std::this_thread::yield();
+                        }
+                        // The destructor waits for the callback, so the flag can be read safely
+                        ++(flag ? invoked : not_invoked);
+                    }
+                });
+        std::this_thread::yield();
+        (void)src.request_stop();
+        for (auto& thread : threads) thread.join();
+        REQUIRE(invoked.load() + not_invoked.load() == thread_count * callbacks_per_thread);
+        // Callbacks registered after the request are invoked inline
+        bool invoked_inline = false;
+        const set_callback cb(src.get_token(), flag_setter{&invoked_inline});
+        REQUIRE(invoked_inline);
+    }
+}
+
+TEST_CASE("optional stop callback", "[stop_token]")
+{
+    SECTION("empty for unstoppable tokens")
+    {
+        using never_cb = clu::optional_stop_callback<clu::never_stop_token, flag_setter>;
+        STATIC_REQUIRE(std::is_empty_v<never_cb>);
+        bool invoked = false;
+        never_cb cb;
+        cb.emplace(clu::never_stop_token{}, flag_setter{&invoked});
+        cb.reset();
+        REQUIRE_FALSE(invoked);
+    }
+
+    SECTION("registers on stoppable tokens")
+    {
+        clu::in_place_stop_source src;
+        bool first = false, second = false;
+        clu::optional_stop_callback<clu::in_place_stop_token, flag_setter> cb1, cb2;
+        cb1.emplace(src.get_token(), flag_setter{&first});
+        cb2.emplace(src.get_token(), flag_setter{&second});
+        cb2.reset();
+        (void)src.request_stop();
+        REQUIRE(first);
+        REQUIRE_FALSE(second);
+    }
+}